@@ -1,11 +1,19 @@
 #pragma once
 #include "ctre/phoenix/CANifier.h"
+#include "ctre/phoenix/CANifierLEDAnimator.h"
 #include "ctre/phoenix/ErrorCode.h"
+#include "ctre/phoenix/ErrorCounters.h"
 #include "ctre/phoenix/paramEnum.h"
 #include "ctre/phoenix/HsvToRgb.h"
 #include "ctre/phoenix/LinearInterpolation.h"
+#include "ctre/phoenix/InterpolationTable.h"
+#include "ctre/phoenix/Drive/DriveKinematics.h"
 #include "ctre/phoenix/Motion/MotionProfileStatus.h"
 #include "ctre/phoenix/Motion/TrajectoryPoint.h"
+#include "ctre/phoenix/Motion/CompactTrajectoryBuffer.h"
+#include "ctre/phoenix/Motion/MotionProfileStreamer.h"
+#include "ctre/phoenix/Motion/MotionProfileTelemetry.h"
+#include "ctre/phoenix/Motion/PreparedMotionProfile.h"
 #include "ctre/phoenix/MotorControl/CAN/TalonSRX.h"
 #include "ctre/phoenix/MotorControl/CAN/VictorSPX.h"
 #include "ctre/phoenix/MotorControl/CAN/WPI_TalonSRX.h"
@@ -16,11 +24,27 @@
 #include "ctre/phoenix/MotorControl/IMotorControllerEnhanced.h"
 #include "ctre/phoenix/Sensors/PigeonIMU.h"
 #include "ctre/phoenix/Signals/MovingAverage.h"
+#include "ctre/phoenix/Signals/FixedMovingAverage.h"
+#include "ctre/phoenix/Signals/FilterBank.h"
+#include "ctre/phoenix/Telemetry/TelemetryRecorder.h"
+#include "ctre/phoenix/Telemetry/TelemetrySources.h"
 #include "ctre/phoenix/Tasking/Schedulers/ConcurrentScheduler.h"
+#include "ctre/phoenix/Tasking/Schedulers/ParallelScheduler.h"
+#include "ctre/phoenix/Tasking/Schedulers/PriorityScheduler.h"
+#include "ctre/phoenix/Tasking/Schedulers/ParallelGroup.h"
 #include "ctre/phoenix/Tasking/ILoopable.h"
 #include "ctre/phoenix/Tasking/IProcessable.h"
 #include "ctre/phoenix/Tasking/ButtonMonitor.h"
+#include "ctre/phoenix/Tasking/ControllerMonitor.h"
+#include "ctre/phoenix/Tasking/PeriodicExecutor.h"
+#include "ctre/phoenix/Tasking/LoopableProfiler.h"
+#include "ctre/phoenix/Tasking/TimerWheel.h"
+#include "ctre/phoenix/Tasking/MpscQueue.h"
+#include "ctre/phoenix/Tasking/CoroutineTask.h"
 #include "ctre/phoenix/Utilities.h"
+#include "ctre/phoenix/Stopwatch.h"
+#include "ctre/phoenix/MonotonicClock.h"
+#include "ctre/phoenix/ZoneProfiler.h"
 
 using namespace ctre;
 using namespace ctre::phoenix;
@@ -70,6 +70,8 @@ public:
 
 	CANifier(int deviceNumber);
 	ErrorCode SetLEDOutput(double percentOutput, LEDChannel ledChannel);
+	ErrorCode SetLEDOutputs(double percentOutputA, double percentOutputB,
+			double percentOutputC);
 	ErrorCode SetGeneralOutput(GeneralPin outputPin, bool outputValue, bool outputEnable);
 	ErrorCode SetGeneralOutputs(int outputBits, int isOutputBits);
 	ErrorCode GetGeneralInputs(PinValues &allPins);
@@ -0,0 +1,115 @@
+#pragma once
+
+#ifndef CTR_EXCLUDE_WPILIB_CLASSES
+
+#include <stdint.h>
+#include "ctre/phoenix/CANifier.h"
+#include "ctre/phoenix/Tasking/ILoopable.h"
+#include "ctre/phoenix/Tasking/IProcessable.h"
+
+namespace ctre {
+namespace phoenix {
+
+/**
+ * Animates an RGB LED strip wired to the three CANifier LED channels.
+ *
+ * Colors are converted to RGB once, when an effect or keyframe is set, using
+ * a hue table built on first use, so each update is only table lookups and
+ * linear blends.  Process() can be called every robot loop, but a new color
+ * is only computed and sent once per update period (normally the CANifier
+ * general control frame period), and only if it changed.  All three channels
+ * are written together.
+ *
+ * Effects:
+ *  - Solid: one color.
+ *  - Pulse: one hue/saturation, brightness ramps between two levels.
+ *  - Rainbow: hue sweeps the color wheel.
+ *  - Keyframes: a list of colors, each held or faded to over a duration,
+ *    played once or looped.
+ */
+class CANifierLEDAnimator: public ctre::phoenix::tasking::IProcessable,
+		public ctre::phoenix::tasking::ILoopable {
+public:
+	static const int kMaxKeyframes = 16;
+
+	enum Effect {
+		Off, Solid, Pulse, Rainbow, Keyframes,
+	};
+
+	CANifierLEDAnimator(CANifier * canifier, int updatePeriodMs = 10);
+	virtual ~CANifierLEDAnimator() {
+	}
+
+	void SetChannels(CANifier::LEDChannel red, CANifier::LEDChannel green,
+			CANifier::LEDChannel blue);
+	void SetUpdatePeriod(int periodMs);
+
+	void SetOff();
+	void SetSolid(double hDegrees, double S, double V);
+	void SetPulse(double hDegrees, double S, int periodMs, double minV,
+			double maxV);
+	void SetRainbow(int periodMs, double S, double V);
+
+	void ClearKeyframes();
+	bool AddKeyframe(double hDegrees, double S, double V, int durationMs,
+			bool fadeIn);
+	void PlayKeyframes(bool loop);
+
+	Effect GetEffect() const;
+	void GetColor(float & r, float & g, float & b) const;
+
+	void Update(uint32_t nowMs);
+
+	/* IProcessable */
+	virtual void Process();
+
+	/* ILoopable */
+	virtual void OnStart();
+	virtual void OnLoop();
+	virtual bool IsDone();
+	virtual void OnStop();
+
+private:
+	struct Rgb {
+		float r, g, b;
+	};
+	struct Keyframe {
+		Rgb color;
+		uint32_t durationMs;
+		bool fadeIn; //!< blend from previous color over duration, else hold
+	};
+
+	CANifier * _canifier;
+	int _channel[3]; //!< LED channel for r, g, b
+	uint32_t _periodMs;
+	bool _hasUpdated = false;
+	uint32_t _lastUpdateMs = 0;
+	uint32_t _startMs = 0;
+	bool _restart = true; //!< effect changed, time base restarts
+
+	Effect _effect = Off;
+	Rgb _base; //!< Solid color, or Pulse color at full brightness
+	float _minV = 0;
+	float _maxV = 0;
+	float _saturation = 0;
+	uint32_t _effectPeriodMs = 1000;
+
+	Keyframe _keys[kMaxKeyframes];
+	int _keyCount = 0;
+	uint32_t _keysTotalMs = 0;
+	bool _loop = false;
+	bool _done = false;
+
+	Rgb _color;
+	int _sent[3]; //!< last duty cycle sent per channel, -1 if none
+
+	static Rgb FromHsv(double hDegrees, double S, double V);
+	static Rgb Blend(const Rgb & a, const Rgb & b, float t);
+	Rgb Evaluate(uint32_t elapsedMs);
+	void Write();
+};
+
+} // namespace phoenix
+} // namespace ctre
+
+#endif // CTR_EXCLUDE_WPILIB_CLASSES
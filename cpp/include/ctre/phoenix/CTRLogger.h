@@ -1,14 +1,30 @@
 #include "ctre/phoenix/ErrorCode.h" // ErrorCode
+#include <stdint.h>
 #include <string>
 
 namespace ctre {
 namespace phoenix {
 
+/**
+ * Reports errors to the Driver Station and log.
+ *
+ * Log() only does the work needed to tell errors apart, so it is safe to
+ * call every loop even while a device is missing.  Errors are deduplicated
+ * by origin, error code and call site.  The first occurrence records the
+ * raw return addresses and is queued, later ones only bump a counter.  A
+ * background thread symbolizes the stack, sends new errors, and
+ * periodically sends how many times each error repeated, limited to a
+ * maximum number of messages per second.
+ */
 class CTRLogger {
 public:
 	static void Close();
 	static ErrorCode Log(ErrorCode code, std::string origin);
+	static ErrorCode Log(ErrorCode code, const char * origin);
 	static void Open(int language);
+	static void SetRateLimit(int messagesPerSecond);
+	static void SetRepeatReportPeriod(int periodMs);
+	static uint32_t GetDroppedCount();
 	//static void Description(ErrorCode code, const char *&shrt, const char *&lng);
 };
 
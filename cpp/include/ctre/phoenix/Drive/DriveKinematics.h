@@ -0,0 +1,74 @@
+#pragma once
+
+#include <vector>
+#include "ctre/phoenix/MotorControl/IMotorController.h"
+
+namespace ctre {
+namespace phoenix {
+namespace drive {
+
+/**
+ * Mixes driver inputs into motor demands for a differential (tank style)
+ * drivetrain with any number of motor controllers per side.
+ *
+ *	DriveKinematics drive;
+ *	drive.Add(&leftFront, DriveKinematics::Left);
+ *	drive.Add(&leftRear, DriveKinematics::Left);
+ *	drive.Add(&rightFront, DriveKinematics::Right, -1); // mounted reversed
+ *	drive.Add(&rightRear, DriveKinematics::Right, -1);
+ *	...
+ *	drive.Arcade(-stick.GetY(), stick.GetX());
+ *
+ * Each mix applies the deadband to the inputs, desaturates the two side
+ * outputs so their ratio is kept when one exceeds full output, and scales by
+ * the peak output.  The two side values are then fanned out to every
+ * channel as one branch free multiply-add over the demand batch, and each
+ * controller's demand is sent with Set().
+ */
+class DriveKinematics {
+public:
+	enum Side {
+		Left, Right,
+	};
+
+	DriveKinematics();
+
+	int Add(ctre::phoenix::motorcontrol::IMotorController * motorController,
+			Side side, float gain = 1);
+	void SetDeadband(float deadband);
+	void SetPeakOutput(float peak);
+	void SetControlMode(ctre::phoenix::motorcontrol::ControlMode mode,
+			float fullScale = 1);
+
+	void Arcade(float forward, float turn);
+	void Curvature(float forward, float curvature, bool quickTurn);
+	void Tank(float left, float right);
+	void Stop();
+
+	int GetCount() const;
+	const float * GetDemands() const;
+	void GetSides(float & left, float & right) const;
+
+	static float ApplyDeadband(float value, float deadband);
+	static void Desaturate(float & left, float & right);
+
+private:
+	std::vector<ctre::phoenix::motorcontrol::IMotorController *> _motors;
+	/* demand[i] = leftGain[i] * left + rightGain[i] * right */
+	std::vector<float> _leftGain;
+	std::vector<float> _rightGain;
+	std::vector<float> _demand;
+
+	float _deadband;
+	float _peak;
+	ctre::phoenix::motorcontrol::ControlMode _mode;
+	float _fullScale; //!< demand sent for full output in _mode
+	float _left;
+	float _right;
+
+	void Output(float left, float right);
+};
+
+} // namespace drive
+} // namespace phoenix
+} // namespace ctre
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <stdint.h>
+#include <atomic>
+#include "ctre/phoenix/ErrorCode.h"
+
+namespace ctre {
+namespace phoenix {
+
+/**
+ * Counts the error codes returned by each device's low level calls, so
+ * communication health can be shown without logging every failure.
+ *
+ * Every device registers its handle when constructed, and every call into
+ * the device passes its ErrorCode through Count().  A call that succeeds
+ * only costs the comparison against OKAY.  An error bumps the device's
+ * counter for that code with relaxed atomics and records the first and last
+ * time it was seen.  Warnings (positive codes, e.g. BufferFull from a full
+ * motion profile buffer) are part of normal operation and are not counted.
+ * Read the counters from any thread with GetSnapshot().
+ *
+ * Reset() doesn't clear anything the counting path writes, it records the
+ * current counts as a baseline that snapshots subtract.  So it is safe to
+ * call while devices are in use.
+ *
+ *	ErrorCounters::Snapshot snaps[ErrorCounters::kMaxDevices];
+ *	int n = ErrorCounters::GetSnapshot(snaps, ErrorCounters::kMaxDevices);
+ *	for (int i = 0; i < n; ++i)
+ *		if (snaps[i].totalCount > 0) ...
+ */
+class ErrorCounters {
+public:
+	static const int kMaxDevices = 64;
+	static const int kMaxCodes = 48; //!< distinct error codes tracked
+
+	enum DeviceType {
+		TalonSRX, VictorSPX, PigeonIMU, CANifier,
+	};
+
+	struct CodeCount {
+		ErrorCode code;
+		uint32_t count;
+		int64_t firstUs; //!< MonotonicClock time of first occurrence since Reset()
+		int64_t lastUs; //!< MonotonicClock time of latest occurrence
+	};
+	struct Snapshot {
+		DeviceType type;
+		int deviceNumber;
+		uint32_t totalCount; //!< sum of all error counts since Reset()
+		int codeCount; //!< entries filled in codes, only codes seen since Reset()
+		CodeCount codes[kMaxCodes];
+	};
+
+	static void Register(void * handle, DeviceType type, int deviceNumber);
+	static void Unregister(void * handle);
+
+	/**
+	 * Count code against the device if it is an error (negative).
+	 * @param handle device's low level handle.
+	 * @param code result of the low level call.
+	 * @return code, so calls can be wrapped in place.
+	 */
+	static ErrorCode Count(void * handle, ErrorCode code) {
+		if (code < OKAY)
+			CountError(handle, code);
+		return code;
+	}
+
+	static int GetSnapshot(Snapshot * snapshots, int capacity);
+	static bool GetSnapshot(DeviceType type, int deviceNumber,
+			Snapshot & snapshot);
+	static void Reset();
+
+private:
+	static void CountError(void * handle, ErrorCode code);
+};
+
+} // namespace phoenix
+} // namespace ctre
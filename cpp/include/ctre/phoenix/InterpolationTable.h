@@ -0,0 +1,62 @@
+#pragma once
+
+#include <vector>
+
+namespace ctre {
+namespace phoenix {
+
+/**
+ * Piecewise linear lookup table, e.g. for joystick shaping, shooter RPM
+ * maps or mapping RC pulse widths.
+ *
+ * Breakpoints are given once at construction.  If they are evenly spaced
+ * the segment is found in O(1), otherwise with a binary search.  Outside the
+ * table the output is either clamped to the end values or extrapolated from
+ * the end segments.
+ */
+class InterpolationTable {
+public:
+	enum OutOfRange {
+		Clamp, Extrapolate,
+	};
+
+	InterpolationTable(const double * x, const double * y, int count,
+			OutOfRange outOfRange = Clamp);
+	InterpolationTable(double xMin, double xMax, const double * y, int count,
+			OutOfRange outOfRange = Clamp);
+	/**
+	 * Construct from fixed size arrays, e.g.
+	 *	static const double x[] = {0, 0.5, 1};
+	 *	static const double y[] = {0, 0.2, 1};
+	 *	InterpolationTable shaping(x, y);
+	 */
+	template<int N>
+	InterpolationTable(const double (&x)[N], const double (&y)[N],
+			OutOfRange outOfRange = Clamp) :
+			InterpolationTable(x, y, N, outOfRange) {
+	}
+
+	double Lookup(double x) const;
+	void Lookup(const double * x, double * y, int count) const;
+
+	bool IsUniform() const {
+		return _uniform;
+	}
+	int GetCount() const {
+		return (int) _y.size();
+	}
+
+private:
+	std::vector<double> _x;
+	std::vector<double> _y;
+	std::vector<double> _slope; //!< per segment, precomputed
+	OutOfRange _outOfRange;
+	bool _uniform;
+	double _invStep; //!< 1 / spacing when uniform
+
+	void Init();
+	int FindSegment(double x) const;
+};
+
+} // namespace phoenix
+} // namespace ctre
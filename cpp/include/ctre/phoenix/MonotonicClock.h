@@ -0,0 +1,31 @@
+#pragma once
+
+#include <stdint.h>
+#include <chrono>
+
+namespace ctre {
+namespace phoenix {
+
+/**
+ * Monotonic wall time, unaffected by system clock changes and counting
+ * while the thread is blocked.  Use for measuring durations.
+ */
+class MonotonicClock {
+public:
+	/** @return nanoseconds since an arbitrary fixed point */
+	static int64_t NowNs() {
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(
+				std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+	/** @return microseconds since an arbitrary fixed point */
+	static int64_t NowUs() {
+		return NowNs() / 1000;
+	}
+	/** @return milliseconds since an arbitrary fixed point */
+	static int64_t NowMs() {
+		return NowNs() / 1000000;
+	}
+};
+
+} // namespace phoenix
+} // namespace ctre
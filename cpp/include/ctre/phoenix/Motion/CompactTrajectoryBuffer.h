@@ -0,0 +1,54 @@
+#pragma once
+
+#include "ctre/phoenix/Motion/CompactTrajectoryPoint.h"
+
+namespace ctre {
+namespace phoenix {
+namespace motion {
+
+/**
+ * Fixed capacity ring buffer of quantized trajectory points.
+ * Application can hold an entire profile here and stream it into the motor
+ * controller's top buffer as room allows, see
+ * BaseMotorController::PushMotionProfileTrajectories().
+ * Approx memory footprint is capacity X 12 bytes, allocated once.
+ */
+class CompactTrajectoryBuffer {
+public:
+	CompactTrajectoryBuffer(int capacity);
+	~CompactTrajectoryBuffer();
+	CompactTrajectoryBuffer() = delete;
+	CompactTrajectoryBuffer(CompactTrajectoryBuffer const&) = delete;
+	CompactTrajectoryBuffer& operator=(CompactTrajectoryBuffer const&) = delete;
+
+	bool Write(const TrajectoryPoint & pt);
+	bool Write(const CompactTrajectoryPoint & pt);
+	const CompactTrajectoryPoint * Front() const;
+	int Peek(const CompactTrajectoryPoint * & pts) const;
+	bool Pop();
+	int Pop(int count);
+	void Clear();
+
+	int GetCount() const {
+		return _cnt;
+	}
+	int GetCapacity() const {
+		return _cap;
+	}
+	bool IsEmpty() const {
+		return _cnt == 0;
+	}
+	bool IsFull() const {
+		return _cnt >= _cap;
+	}
+private:
+	CompactTrajectoryPoint * _d; //!< ring buffer
+	int _cap; //!< capacity of ring buffer
+	int _in = 0; //!< head ptr for ringbuffer
+	int _ou = 0; //!< tail ptr for ringbuffer
+	int _cnt = 0; //!< number of element in ring buffer
+};
+
+} // namespace motion
+} // namespace phoenix
+} // namespace ctre
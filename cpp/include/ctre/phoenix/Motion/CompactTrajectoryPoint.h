@@ -0,0 +1,50 @@
+#pragma once
+
+#include <stdint.h>
+#include "ctre/phoenix/Motion/TrajectoryPoint.h"
+
+namespace ctre {
+namespace phoenix {
+namespace motion {
+
+/**
+ * Motion Profile Trajectory Point, quantized to the integral units the
+ * motor controller actually executes.
+ *
+ * A TrajectoryPoint carries three doubles (32 bytes with padding), while the
+ * Control_6 frame only transports integral sensor units and a fixed-point
+ * heading.  Storing long profiles in this form costs 12 bytes per point, and
+ * the quantization is done once when the point is written instead of each
+ * time it is streamed.
+ */
+struct CompactTrajectoryPoint {
+	/** Heading is stored as fixed-point with 8 fractional bits (1/256 deg). */
+	static const int kHeadingFractionalBits = 8;
+	/** Largest slot profileSlotSelect can hold, larger ones are saturated. */
+	static const uint32_t kMaxProfileSlotSelect = 63;
+
+	int32_t position; //!< The position to servo to, in sensor units.
+	int32_t velocity; //!< The velocity to feed-forward, in sensor units per 100ms.
+	int32_t headingFxp :24; //!< Heading in 1/256 degree, range is +-32768 degrees.
+	uint32_t profileSlotSelect :6; //!< Which slot to get PIDF gains.
+	uint32_t isLastPoint :1; //!< @see TrajectoryPoint::isLastPoint
+	uint32_t zeroPos :1; //!< @see TrajectoryPoint::zeroPos
+
+	/**
+	 * Quantize a trajectory point.  Position and velocity are rounded to the
+	 * nearest sensor unit, values out of range are saturated and NaN becomes
+	 * zero.  profileSlotSelect is saturated to kMaxProfileSlotSelect.
+	 */
+	static CompactTrajectoryPoint FromTrajectoryPoint(const TrajectoryPoint & pt);
+	/**
+	 * Expand back into a trajectory point.  This is exact, pushing the result
+	 * into the motor controller's buffer performs no further rounding.
+	 */
+	void ToTrajectoryPoint(TrajectoryPoint & pt) const;
+	/** @return heading in degrees. */
+	double GetHeadingDeg() const;
+};
+
+} // namespace motion
+} // namespace phoenix
+} // namespace ctre
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "ctre/phoenix/Motion/PreparedMotionProfile.h"
+#include "ctre/phoenix/Tasking/IProcessable.h"
+
+/* forward proto's */
+namespace ctre {
+namespace phoenix {
+namespace motorcontrol {
+namespace can {
+class BaseMotorController;
+}
+}
+}
+}
+
+namespace ctre {
+namespace phoenix {
+namespace motion {
+
+/**
+ * Streams a PreparedMotionProfile into a motor controller.
+ * Each call to Process() copies the next prepared points into the top level
+ * buffer (keeping it no deeper than topBufferDepth), then funnels the top
+ * buffer into the controller.  Call Process() at least twice as fast as the
+ * trajectory point duration.
+ *
+ * Because only a few points are handed to the top level buffer at a time, the
+ * rest of the profile can be re-planned while it executes with Splice(),
+ * without clearing the buffers.
+ *
+ * Points are sent with BaseMotorController::PushMotionProfileTrajectories(),
+ * the same drain used for a CompactTrajectoryBuffer.  The CCI only accepts
+ * points as doubles, so "prepared" means quantized once, up front: each point
+ * is still handed over field by field, but since its values are already
+ * integral (and the heading fixed-point) the low level encodes it exactly.
+ */
+class MotionProfileStreamer: public ctre::phoenix::tasking::IProcessable {
+public:
+	MotionProfileStreamer(
+			ctre::phoenix::motorcontrol::can::BaseMotorController * motorController,
+			int topBufferDepth = 16);
+	virtual ~MotionProfileStreamer() {
+	}
+
+	void Start(PreparedMotionProfile * profile);
+	void Stop();
+	/** @return index of the next point to be sent to the top level buffer. */
+	int GetNextIndex() const {
+		return _idx;
+	}
+	int Splice(int fromIndex, const TrajectoryPoint * points, int count,
+			int blendPoints = 0);
+	int SpliceAtTime(int timeMs, int pointDurationMs,
+			const TrajectoryPoint * points, int count, int blendPoints = 0);
+	/** @return number of prepared points not yet sent. */
+	int GetRemaining() const;
+	/** @return true if every prepared point has been sent. */
+	bool IsDone() const;
+
+	/* IProcessable */
+	virtual void Process();
+
+private:
+	ctre::phoenix::motorcontrol::can::BaseMotorController * _motorController;
+	PreparedMotionProfile * _profile = nullptr;
+	int _topBufferDepth;
+	int _idx = 0;
+};
+
+} // namespace motion
+} // namespace phoenix
+} // namespace ctre
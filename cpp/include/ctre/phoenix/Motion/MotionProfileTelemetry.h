@@ -0,0 +1,93 @@
+#pragma once
+
+#include <stdint.h>
+#include "ctre/phoenix/Motion/MotionProfileStatus.h"
+#include "ctre/phoenix/Tasking/IProcessable.h"
+
+/* forward proto's */
+namespace ctre {
+namespace phoenix {
+namespace motorcontrol {
+class IMotorController;
+}
+}
+}
+
+namespace ctre {
+namespace phoenix {
+namespace motion {
+
+/**
+ * Samples motion profile buffer levels every tick to catch an underrun
+ * before it happens.
+ *
+ * The drain rate (points consumed by the motion profile executer) starts at
+ * the nominal rate given by the trajectory point duration, and is refined
+ * whenever the top buffer is empty (no fill, so the bottom buffer only
+ * drains).  The fill rate is then derived from the change in bottom buffer
+ * count.  When the bottom buffer is predicted to empty within the warning
+ * threshold an early warning is raised, and optionally the Control_6 frame
+ * period is shortened to speed up the download.  The original period is put
+ * back once the profile stops executing, or when auto frame period is
+ * disabled.
+ */
+class MotionProfileTelemetry: public ctre::phoenix::tasking::IProcessable {
+public:
+	static const int kHistogramBins = 16;
+	static const int kHistogramBinWidth = 8; //!< Talon buffers up to 128 points
+
+	MotionProfileTelemetry(
+			ctre::phoenix::motorcontrol::IMotorController * motorController,
+			int trajectoryPointDurationMs);
+	virtual ~MotionProfileTelemetry() {
+	}
+
+	void Sample(const MotionProfileStatus & status, double timestampSec);
+	void Reset();
+
+	void SetWarningThreshold(double seconds);
+	void EnableAutoFramePeriod(bool enable, int initialPeriodMs = 10,
+			int minPeriodMs = 2);
+
+	double GetFillRate() const; //!< points per second into bottom buffer
+	double GetDrainRate() const; //!< points per second out of bottom buffer
+	double GetTimeToUnderrun() const; //!< seconds, negative if not draining
+	bool IsUnderrunPredicted() const;
+	int GetWarningCount() const;
+	int GetUnderrunSampleCount() const;
+	int GetControlFramePeriodMs() const;
+	const uint32_t * GetDepthHistogram() const;
+
+	/* IProcessable */
+	virtual void Process();
+
+private:
+	ctre::phoenix::motorcontrol::IMotorController * _motorController;
+	double _nominalDrainRate;
+	double _fillRate = 0;
+	double _drainRate;
+	double _timeToUnderrun = -1;
+	double _warningThreshold = 0.1;
+	bool _underrunPredicted = false;
+
+	bool _hasWindow = false;
+	bool _windowTopEmpty = false;
+	int _windowBtmCnt = 0;
+	double _windowTimestamp = 0;
+
+	bool _autoFramePeriod = false;
+	int _control6PeriodMs = 10;
+	int _originalControl6PeriodMs = 10; //!< period before any shortening
+	int _minControl6PeriodMs = 2;
+
+	int _warningCount = 0;
+	int _underrunSampleCount = 0;
+	uint32_t _depthHistogram[kHistogramBins];
+
+	void ShortenFramePeriod();
+	void RestoreFramePeriod();
+};
+
+} // namespace motion
+} // namespace phoenix
+} // namespace ctre
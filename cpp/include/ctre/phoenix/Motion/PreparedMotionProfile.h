@@ -0,0 +1,47 @@
+#pragma once
+
+#include <vector>
+#include "ctre/phoenix/Motion/CompactTrajectoryPoint.h"
+
+namespace ctre {
+namespace phoenix {
+namespace motion {
+
+/**
+ * A complete motion profile encoded ahead of time.
+ * All points are quantized and have their slot/zeroPos/isLast flags resolved
+ * during Prepare(), so streaming only copies the stored points.  The profile
+ * is not consumed by streaming, so it can be replayed any number of times.
+ * Points use the same encoding as CompactTrajectoryBuffer, which is the
+ * better fit for a profile that is generated while it streams.
+ * The unsent tail can be replaced while streaming, see Splice().
+ */
+class PreparedMotionProfile {
+public:
+	PreparedMotionProfile() {
+	}
+	void Prepare(const TrajectoryPoint * points, int count);
+	void Prepare(const std::vector<TrajectoryPoint> & points);
+	void Prepare(const double positions[], const double velocities[],
+			const double headingsDeg[], int count, int profileSlotSelect,
+			bool zeroPosOnFirst);
+	void Splice(int fromIndex, const TrajectoryPoint * points, int count,
+			int blendPoints);
+	void Clear();
+
+	int GetCount() const {
+		return (int) _pts.size();
+	}
+	const CompactTrajectoryPoint & Get(int idx) const {
+		return _pts[idx];
+	}
+	const CompactTrajectoryPoint * GetPoints() const {
+		return _pts.data();
+	}
+private:
+	std::vector<CompactTrajectoryPoint> _pts;
+};
+
+} // namespace motion
+} // namespace phoenix
+} // namespace ctre
@@ -0,0 +1,53 @@
+#pragma once
+
+namespace ctre {
+namespace phoenix {
+namespace motion {
+namespace sim {
+
+/**
+ * Simple model of one or more identical brushed DC motors driving an
+ * inertial load through a gearbox, with a sensor on the output shaft.
+ * Motor constants are taken from the motor's datasheet (free speed, stall
+ * torque and currents at nominal voltage).
+ */
+class DCMotorPlant {
+public:
+	struct Params {
+		double freeSpeedRpm = 5330; //!< CIM defaults
+		double stallTorqueNm = 2.41;
+		double stallCurrentAmps = 131;
+		double freeCurrentAmps = 2.7;
+		double nominalVoltage = 12;
+		int motorCount = 1;
+		double gearRatio = 10; //!< motor turns per output turn
+		double momentOfInertia = 0.01; //!< kg*m^2 seen at the output
+		double viscousDamping = 0; //!< N*m per rad/s at the output
+		double sensorUnitsPerRev = 4096; //!< CTRE Mag Encoder
+	};
+
+	DCMotorPlant(const Params & params);
+
+	void Step(double outputPercent, double busVoltage, double dtSec);
+	void Reset();
+	void ZeroPosition();
+
+	double GetPositionUnits() const; //!< sensor units
+	double GetVelocityUnitsPer100ms() const; //!< sensor units per 100ms
+	double GetCurrentAmps() const; //!< total current of all motors
+private:
+	Params _params;
+	double _resistance;
+	double _kT; //!< N*m per amp
+	double _kV; //!< rad/s per volt
+
+	double _positionRad = 0; //!< output shaft
+	double _velocityRadPerSec = 0; //!< output shaft
+	double _zeroOffsetRad = 0;
+	double _currentAmps = 0;
+};
+
+} // namespace sim
+} // namespace motion
+} // namespace phoenix
+} // namespace ctre
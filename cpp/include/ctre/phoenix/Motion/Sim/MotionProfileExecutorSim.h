@@ -0,0 +1,118 @@
+#pragma once
+
+#include <vector>
+#include <stdint.h>
+#include "ctre/phoenix/Motion/TrajectoryPoint.h"
+#include "ctre/phoenix/Motion/MotionProfileStatus.h"
+#include "ctre/phoenix/Motion/Sim/DCMotorPlant.h"
+
+namespace ctre {
+namespace phoenix {
+namespace motion {
+namespace sim {
+
+/**
+ * Host-side model of the motor controller's Motion Profile Executer (MPE).
+ *
+ * Points are executed for their duration, then the next buffered point is
+ * popped.  The selected slot's PIDF runs every 1ms against a DCMotorPlant,
+ * using the same units as the controller (output scaled to 1023, position in
+ * sensor units, velocity in sensor units per 100ms).  Nothing here waits on
+ * real time, so a full profile runs as fast as the host can step it, which
+ * allows batch testing of profiles and gains off the robot.
+ *
+ * Output enable follows SetValueMotionProfile:
+ *   Disable: output is neutral, the MPE does not run and the active point is
+ *            cleared.  Buffered points are kept.
+ *   Enable:  MPE processes the buffered points.
+ *   Hold:    MPE keeps servoing the active point and does not advance.
+ */
+class MotionProfileExecutorSim {
+public:
+	static const int kSlotCount = 4;
+	static const int kLoopPeriodMs = 1;
+
+	struct SlotGains {
+		double kP = 0;
+		double kI = 0;
+		double kD = 0;
+		double kF = 0;
+		int integralZone = 0; //!< zero means no zone
+	};
+
+	/** Error statistics gathered since last Reset() */
+	struct Stats {
+		int elapsedMs = 0;
+		int pointsExecuted = 0;
+		int underrunMs = 0;
+		double maxAbsError = 0; //!< sensor units
+		double sumSqError = 0;
+		int errorSamples = 0;
+		double peakCurrentAmps = 0;
+		double GetRmsError() const;
+	};
+
+	MotionProfileExecutorSim(DCMotorPlant * plant);
+
+	void ConfigSlot(int slotIdx, const SlotGains & gains);
+	void ConfigPeakOutput(double percentOut);
+	void SetBusVoltage(double volts);
+	void SetTrajectoryPeriod(int durationMs);
+
+	bool PushMotionProfileTrajectory(const TrajectoryPoint & trajPt,
+			int durationMs = 0);
+	void ClearMotionProfileTrajectories();
+	void SetOutputEnable(SetValueMotionProfile outputEnable);
+
+	void Step();
+	int Run(int durationMs);
+	int RunUntilDone(int timeoutMs);
+	void Reset();
+
+	void GetMotionProfileStatus(MotionProfileStatus & statusToFill) const;
+	double GetMotorOutputPercent() const;
+	int GetSelectedSensorPosition() const;
+	int GetSelectedSensorVelocity() const;
+	double GetClosedLoopError() const;
+	int GetActiveTrajectoryPosition() const;
+	int GetActiveTrajectoryVelocity() const;
+	const Stats & GetStats() const;
+
+private:
+	struct SimPoint {
+		TrajectoryPoint pt;
+		int durationMs;
+	};
+
+	DCMotorPlant * _plant;
+	SlotGains _slots[kSlotCount];
+	double _peakOutput = 1.0;
+	double _busVoltage = 12.0;
+	int _defaultDurationMs = 10;
+
+	std::vector<SimPoint> _buffer;
+	unsigned int _bufferIdx = 0;
+
+	SetValueMotionProfile _outputEnable = SetValueMotionProfile::Disable;
+	bool _activeValid = false;
+	SimPoint _active;
+	int _activeRemainingMs = 0;
+	bool _isUnderrun = false;
+	bool _hasUnderrun = false;
+
+	double _iAccum = 0;
+	double _lastError = 0;
+	double _closedLoopError = 0;
+	double _output = 0;
+
+	Stats _stats;
+
+	bool PopNextPoint();
+	void ServoActivePoint();
+	bool IsDone() const;
+};
+
+} // namespace sim
+} // namespace motion
+} // namespace phoenix
+} // namespace ctre
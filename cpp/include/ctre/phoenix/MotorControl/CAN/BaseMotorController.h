@@ -5,11 +5,13 @@
 #include "ctre/phoenix/core/GadgeteerUartClient.h"
 #include "ctre/phoenix/MotorControl/IMotorController.h"
 #include "ctre/phoenix/MotorControl/ControlMode.h"
+#include "ctre/phoenix/MotorControl/DemandEncoding.h"
 #include "ctre/phoenix/MotorControl/Faults.h"
 #include "ctre/phoenix/MotorControl/StickyFaults.h"
 #include "ctre/phoenix/MotorControl/VelocityMeasPeriod.h"
 #include "ctre/phoenix/Motion/TrajectoryPoint.h"
 #include "ctre/phoenix/Motion/MotionProfileStatus.h"
+#include "ctre/phoenix/Motion/CompactTrajectoryBuffer.h"
 /* WPILIB */
 #include "SpeedController.h"
 
@@ -53,6 +55,8 @@ private:
 protected:
 	void* m_handle;
 	void* GetHandle();
+	void SetEncodedDemand(ControlMode mode, double setPoint, int demand0,
+			int demand1);
 public:
 	BaseMotorController(int arbId);
 	~BaseMotorController();
@@ -62,6 +66,20 @@ public:
 	int GetDeviceID();
 	virtual void Set(ControlMode Mode, double value);
 	virtual void Set(ControlMode mode, double demand0, double demand1);
+	/**
+	 * Set with the control mode fixed at compile time, e.g.
+	 *	talon.Set<ControlMode::Velocity>(targetVel);
+	 * Not virtual, the demand scaling for the mode is resolved at compile
+	 * time and inlined, leaving one direct call to send the frame.
+	 * Follower is not supported, use Follow().
+	 * @param demand0 output value, same units as Set(ControlMode, double).
+	 * @param demand1 supplemental value.
+	 */
+	template<ControlMode M>
+	void Set(double demand0, double demand1 = 0) {
+		SetEncodedDemand(M, demand0, DemandEncoding<M>::Demand0(demand0),
+				DemandEncoding<M>::Demand1(demand1));
+	}
 	virtual void NeutralOutput();
 	virtual void SetNeutralMode(NeutralMode neutralMode);
 	void EnableHeadingHold(bool enable);
@@ -181,6 +199,14 @@ public:
 	virtual int GetMotionProfileTopLevelBufferCount();
 	virtual ctre::phoenix::ErrorCode PushMotionProfileTrajectory(
 			const ctre::phoenix::motion::TrajectoryPoint & trajPt);
+	ctre::phoenix::ErrorCode PushMotionProfileTrajectory(
+			const ctre::phoenix::motion::CompactTrajectoryPoint & trajPt);
+	int PushMotionProfileTrajectories(
+			ctre::phoenix::motion::CompactTrajectoryBuffer & source,
+			int maxTopBufferCnt);
+	int PushMotionProfileTrajectories(
+			const ctre::phoenix::motion::CompactTrajectoryPoint * points,
+			int count, int maxTopBufferCnt);
 	virtual bool IsMotionProfileTopLevelBufferFull();
 	virtual void ProcessMotionProfileBuffer();
 	virtual ctre::phoenix::ErrorCode GetMotionProfileStatus(
@@ -55,6 +55,11 @@ public:
 	//----------------------- Intercept CTRE calls for motor safety -------------------//
 	virtual void Set(ControlMode mode, double value);
 	virtual void Set(ControlMode mode, double demand0, double demand1);
+	template<ControlMode M>
+	void Set(double demand0, double demand1 = 0) {
+		VictorSPX::Set<M>(demand0, demand1);
+		_safetyHelper.Feed();
+	}
 	//----------------------- Invert routines -------------------//
 	/**
 	 * Common interface for inverting direction of a speed controller.
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "ctre/phoenix/MotorControl/ControlMode.h"
+
+namespace ctre {
+namespace phoenix {
+namespace motorcontrol {
+
+/**
+ * Converts a demand in caller units to the integers sent in the control
+ * frame, for a control mode known at compile time.  Used by
+ * BaseMotorController::Set<ControlMode>() so the scaling folds into the call
+ * site, and by the runtime Set() so both always encode the same way.
+ *
+ * Modes without a specialization (Follower, MotionProfileArc) are not
+ * supported at compile time, use the runtime Set() or Follow().
+ */
+template<ControlMode M>
+struct DemandEncoding;
+
+/** [-1,1] sent as [-1023,1023] */
+template<>
+struct DemandEncoding<ControlMode::PercentOutput> {
+	static int Demand0(double demand0) {
+		return (int) (1023 * demand0);
+	}
+	static int Demand1(double demand1) {
+		return (int) (1023 * demand1);
+	}
+};
+/** amperes sent as milliamps */
+template<>
+struct DemandEncoding<ControlMode::Current> {
+	static int Demand0(double demand0) {
+		return (int) (1000 * demand0);
+	}
+	static int Demand1(double) {
+		return 0;
+	}
+};
+/** closed loop targets are sent in native sensor units */
+struct NativeUnitsDemandEncoding {
+	static int Demand0(double demand0) {
+		return (int) demand0;
+	}
+	static int Demand1(double demand1) {
+		return (int) (1023 * demand1);
+	}
+};
+template<>
+struct DemandEncoding<ControlMode::Position> : NativeUnitsDemandEncoding {
+};
+template<>
+struct DemandEncoding<ControlMode::Velocity> : NativeUnitsDemandEncoding {
+};
+template<>
+struct DemandEncoding<ControlMode::MotionMagic> : NativeUnitsDemandEncoding {
+};
+template<>
+struct DemandEncoding<ControlMode::MotionMagicArc> : NativeUnitsDemandEncoding {
+};
+template<>
+struct DemandEncoding<ControlMode::MotionProfile> : NativeUnitsDemandEncoding {
+};
+template<>
+struct DemandEncoding<ControlMode::Disabled> {
+	static int Demand0(double) {
+		return 0;
+	}
+	static int Demand1(double) {
+		return 0;
+	}
+};
+
+} // namespace motorcontrol
+} // namespace phoenix
+} // namespace ctre
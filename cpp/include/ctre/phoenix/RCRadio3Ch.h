@@ -1,7 +1,7 @@
 #pragma once
 
-#include <vector>
 #include "ctre/phoenix/CANifier.h"
+#include "ctre/phoenix/InterpolationTable.h"
 #include "ctre/phoenix/Tasking/IProcessable.h"
 
 namespace ctre{
@@ -43,7 +43,7 @@ private:
 			{ 0, 0 },
 			{ 0, 0 },
 	};
-	double Interpolate(std::vector<double> &xData, std::vector<double> &yData, double x, bool extrapolate);
+	InterpolationTable _pulseToPerc; //!< 1000-2000us to -1..1, clamped
 };
 
 }}
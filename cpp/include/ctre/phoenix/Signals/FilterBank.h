@@ -0,0 +1,288 @@
+#pragma once
+
+#include "ctre/phoenix/Signals/FixedMovingAverage.h"
+
+namespace ctre {
+namespace phoenix {
+namespace signals {
+
+/**
+ * Filter kinds for FilterBank.
+ */
+namespace filters {
+/** y += gain * (x - y), gain per channel in (0,1] */
+struct FirstOrderIir {
+};
+/** mean of the last Window samples */
+template<int Window>
+struct MovingAverage {
+	static_assert(Window > 0, "MovingAverage needs a window of at least 1");
+};
+/** median of the last five samples, rejects single sample spikes */
+struct MedianOf5 {
+};
+/** output follows input but changes by at most rate per tick, per channel */
+struct SlewLimiter {
+};
+} // namespace filters
+
+/**
+ * Runs the same filter on many signals at once, e.g. current, velocity and
+ * voltage of every motor controller.
+ *
+ * State is stored struct-of-arrays (one array per state variable, indexed by
+ * channel) and every channel steps on the same Process() call, so each step
+ * is a straight loop over channels with no branches the compiler can't turn
+ * into selects.  The moving average is a FixedMovingAverage whose sample is
+ * a row of all channels.  This lets it vectorize, and keeps all the state in a few
+ * contiguous cache lines instead of one heap object per signal.
+ *
+ *	FilterBank<filters::MovingAverage<8>, 36> currents;
+ *	float raw[36], filtered[36];
+ *	...
+ *	currents.Process(raw, filtered);
+ *
+ * @param Kind one of the filters:: kinds.
+ * @param Channels number of signals.
+ */
+template<typename Kind, int Channels>
+class FilterBank;
+
+//--------------------- FirstOrderIir -----------------------------//
+template<int Channels>
+class FilterBank<filters::FirstOrderIir, Channels> {
+public:
+	FilterBank(float gain = 1.0f) {
+		SetGainAll(gain);
+		Reset();
+	}
+	void SetGain(int channel, float gain) {
+		_gain[channel] = gain;
+	}
+	void SetGainAll(float gain) {
+		for (int i = 0; i < Channels; ++i)
+			_gain[i] = gain;
+	}
+	/**
+	 * Step every channel.  The first call after Reset() passes the inputs
+	 * through so the filter doesn't ramp up from zero.
+	 * @param input one sample per channel.
+	 * @param output filtered value per channel, may be the same as input.
+	 */
+	void Process(const float * input, float * output) {
+		if (!_primed) {
+			for (int i = 0; i < Channels; ++i)
+				_y[i] = input[i];
+			_primed = true;
+		} else {
+			for (int i = 0; i < Channels; ++i)
+				_y[i] += _gain[i] * (input[i] - _y[i]);
+		}
+		for (int i = 0; i < Channels; ++i)
+			output[i] = _y[i];
+	}
+	void Reset() {
+		for (int i = 0; i < Channels; ++i)
+			_y[i] = 0;
+		_primed = false;
+	}
+	const float * GetOutputs() const {
+		return _y;
+	}
+private:
+	float _gain[Channels];
+	float _y[Channels];
+	bool _primed;
+};
+
+//--------------------- MovingAverage -----------------------------//
+namespace filters {
+/**
+ * One sample of every channel, with element-wise arithmetic, so a single
+ * FixedMovingAverage can average all channels at once.  Each operator is a
+ * plain loop over channels, which keeps the state struct-of-arrays.
+ */
+template<int Channels>
+struct ChannelSample {
+	float v[Channels];
+
+	ChannelSample() {
+	}
+	/** broadcast, used for the zero and count constants */
+	ChannelSample(int value) {
+		for (int i = 0; i < Channels; ++i)
+			v[i] = (float) value;
+	}
+	ChannelSample & operator+=(const ChannelSample & rhs) {
+		for (int i = 0; i < Channels; ++i)
+			v[i] += rhs.v[i];
+		return *this;
+	}
+	ChannelSample & operator-=(const ChannelSample & rhs) {
+		for (int i = 0; i < Channels; ++i)
+			v[i] -= rhs.v[i];
+		return *this;
+	}
+	ChannelSample operator+(const ChannelSample & rhs) const {
+		ChannelSample retval = *this;
+		retval += rhs;
+		return retval;
+	}
+	ChannelSample operator/(const ChannelSample & rhs) const {
+		ChannelSample retval;
+		for (int i = 0; i < Channels; ++i)
+			retval.v[i] = v[i] / rhs.v[i];
+		return retval;
+	}
+};
+} // namespace filters
+
+template<int Window, int Channels>
+class FilterBank<filters::MovingAverage<Window>, Channels> {
+public:
+	FilterBank() {
+		Reset();
+	}
+	/**
+	 * Step every channel.
+	 * @param input one sample per channel.
+	 * @param output mean of each channel's window, may be the same as input.
+	 */
+	void Process(const float * input, float * output) {
+		filters::ChannelSample<Channels> sample;
+		for (int i = 0; i < Channels; ++i)
+			sample.v[i] = input[i];
+		_avg.Push(sample);
+
+		const float scale = 1.0f / (float) _avg.GetCount();
+		const filters::ChannelSample<Channels> & sum = _avg.GetSum();
+		for (int i = 0; i < Channels; ++i)
+			output[i] = sum.v[i] * scale;
+	}
+	void Reset() {
+		_avg.Clear();
+	}
+	int GetCount() const {
+		return _avg.GetCount();
+	}
+private:
+	/* same ring and once-per-lap resum as a single signal, one row per tick */
+	FixedMovingAverage<filters::ChannelSample<Channels>, Window> _avg;
+};
+
+//--------------------- MedianOf5 -----------------------------//
+template<int Channels>
+class FilterBank<filters::MedianOf5, Channels> {
+public:
+	FilterBank() {
+		Reset();
+	}
+	/**
+	 * Step every channel.  Until five samples are in, missing history is
+	 * filled with the first sample.
+	 * @param input one sample per channel.
+	 * @param output median per channel, may be the same as input.
+	 */
+	void Process(const float * input, float * output) {
+		if (!_primed) {
+			for (int r = 0; r < 5; ++r) {
+				for (int i = 0; i < Channels; ++i)
+					_hist[r][i] = input[i];
+			}
+			_primed = true;
+		}
+		for (int i = 0; i < Channels; ++i)
+			_hist[_in][i] = input[i];
+		if (++_in >= 5)
+			_in = 0;
+
+		for (int i = 0; i < Channels; ++i) {
+			/* branchless median network over five values */
+			float a = _hist[0][i], b = _hist[1][i], c = _hist[2][i];
+			float d = _hist[3][i], e = _hist[4][i];
+			float t;
+			t = Min(a, b); b = Max(a, b); a = t;
+			t = Min(d, e); e = Max(d, e); d = t;
+			/* drop the smallest and largest of (a,d) and (b,e) */
+			a = Max(a, d);
+			b = Min(b, e);
+			/* median of a, b, c */
+			t = Min(a, b); b = Max(a, b); a = t;
+			output[i] = Max(a, Min(b, c));
+		}
+	}
+	void Reset() {
+		_in = 0;
+		_primed = false;
+	}
+private:
+	float _hist[5][Channels];
+	int _in;
+	bool _primed;
+
+	static inline float Min(float x, float y) {
+		return (y < x) ? y : x;
+	}
+	static inline float Max(float x, float y) {
+		return (x < y) ? y : x;
+	}
+};
+
+//--------------------- SlewLimiter -----------------------------//
+template<int Channels>
+class FilterBank<filters::SlewLimiter, Channels> {
+public:
+	FilterBank(float rate = 1.0f) {
+		SetRateAll(rate);
+		Reset();
+	}
+	/**
+	 * @param channel channel to set.
+	 * @param rate largest change per Process(), in the signal's units.
+	 */
+	void SetRate(int channel, float rate) {
+		_rate[channel] = rate;
+	}
+	void SetRateAll(float rate) {
+		for (int i = 0; i < Channels; ++i)
+			_rate[i] = rate;
+	}
+	/**
+	 * Step every channel.  The first call after Reset() passes the inputs
+	 * through.
+	 * @param input one sample per channel.
+	 * @param output limited value per channel, may be the same as input.
+	 */
+	void Process(const float * input, float * output) {
+		if (!_primed) {
+			for (int i = 0; i < Channels; ++i)
+				_y[i] = input[i];
+			_primed = true;
+		} else {
+			for (int i = 0; i < Channels; ++i) {
+				float delta = input[i] - _y[i];
+				delta = (delta > _rate[i]) ? _rate[i] : delta;
+				delta = (delta < -_rate[i]) ? -_rate[i] : delta;
+				_y[i] += delta;
+			}
+		}
+		for (int i = 0; i < Channels; ++i)
+			output[i] = _y[i];
+	}
+	void Reset() {
+		for (int i = 0; i < Channels; ++i)
+			_y[i] = 0;
+		_primed = false;
+	}
+	const float * GetOutputs() const {
+		return _y;
+	}
+private:
+	float _rate[Channels];
+	float _y[Channels];
+	bool _primed;
+};
+
+} // namespace signals
+} // namespace phoenix
+} // namespace ctre
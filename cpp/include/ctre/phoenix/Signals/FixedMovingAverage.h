@@ -0,0 +1,114 @@
+#pragma once
+
+namespace ctre {
+namespace phoenix {
+namespace signals {
+
+/**
+ * Moving average over the last N samples with inline storage, so it never
+ * allocates and can be copied or placed in arrays freely.
+ *
+ * The running sum is recomputed from the window each time the ring wraps
+ * (every N samples), so rounding error never accumulates past one lap no
+ * matter how long it runs.  The recompute uses independent partial sums so
+ * the compiler can vectorize it.
+ *
+ * @param T sample type, float, double or an integer type.  Any type with
+ *          +=, -=, + and / that converts from int also works, FilterBank
+ *          uses one holding a sample of every channel.
+ * @param N window length.
+ */
+template<typename T, int N>
+class FixedMovingAverage {
+	static_assert(N > 0, "FixedMovingAverage needs a window of at least 1");
+public:
+	FixedMovingAverage() {
+		Clear();
+	}
+	/**
+	 * Push a sample.
+	 * @return average of the window including this sample.
+	 */
+	T Process(T input) {
+		Push(input);
+		return _sum / (T) _cnt;
+	}
+	/**
+	 * Push a batch of samples, e.g. everything received since the last loop.
+	 * Only the last N samples affect the result, so large batches cost O(N).
+	 * @param input samples, oldest first.
+	 * @param count number of samples.
+	 * @return average of the window after the last sample, or 0 if empty.
+	 */
+	T Process(const T * input, int count) {
+		if (count >= N) {
+			/* window is entirely replaced, refill and resum in one pass */
+			input += count - N;
+			for (int i = 0; i < N; ++i)
+				_d[i] = input[i];
+			_in = 0;
+			_cnt = N;
+			Resum();
+		} else {
+			for (int i = 0; i < count; ++i)
+				Push(input[i]);
+		}
+		return (_cnt > 0) ? _sum / (T) _cnt : (T) 0;
+	}
+	void Clear() {
+		_in = 0;
+		_cnt = 0;
+		_sum = 0;
+	}
+	void Push(const T & d) {
+		if (_cnt >= N)
+			_sum -= _d[_in]; /* slot being overwritten is the oldest */
+		else
+			++_cnt;
+		_sum += d;
+		_d[_in] = d;
+		if (++_in >= N) {
+			_in = 0;
+			/* drop accumulated rounding error once per lap */
+			Resum();
+		}
+	}
+	//-------------- Properties --------------//
+	const T & GetSum() const {
+		return _sum;
+	}
+	T GetAverage() const {
+		return (_cnt > 0) ? _sum / (T) _cnt : (T) 0;
+	}
+	int GetCount() const {
+		return _cnt;
+	}
+	static int GetCapacity() {
+		return N;
+	}
+
+private:
+	T _d[N]; //!< ring buffer, oldest at _in once full
+	int _in; //!< next slot to write
+	int _cnt; //!< number of samples in window
+	T _sum; //!< sum of window
+
+	/** only called when the ring is full or wraps, so _d[0.._cnt) is the window */
+	void Resum() {
+		T s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+		int i = 0;
+		for (; i + 4 <= _cnt; i += 4) {
+			s0 += _d[i];
+			s1 += _d[i + 1];
+			s2 += _d[i + 2];
+			s3 += _d[i + 3];
+		}
+		for (; i < _cnt; ++i)
+			s0 += _d[i];
+		_sum = (s0 + s1) + (s2 + s3);
+	}
+};
+
+} // namespace signals
+} // namespace phoenix
+} // namespace ctre
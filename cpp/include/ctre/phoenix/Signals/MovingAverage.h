@@ -20,11 +20,18 @@
  * SIMILAR COSTS, WHETHER ASSERTED ON THE BASIS OF CONTRACT, TORT
  * (INCLUDING NEGLIGENCE), BREACH OF WARRANTY, OR OTHERWISE
  */
+#pragma once
 
 namespace ctre {
 namespace phoenix {
 namespace signals {
 
+/**
+ * Moving average over the last capacity samples.
+ * The running sum is recomputed from the buffer each time the ring wraps, so
+ * rounding error can't build up over a long run.  See FixedMovingAverage for
+ * an allocation-free version with compile time capacity.
+ */
 class MovingAverage {
 private:
 
@@ -40,6 +47,12 @@ public:
 		_d = new float[_cap];
 		Clear();
 	}
+	~MovingAverage() {
+		delete[] _d;
+		_d = 0;
+	}
+	MovingAverage(MovingAverage const&) = delete;
+	MovingAverage& operator=(MovingAverage const&) = delete;
 	float Process(float input) {
 		Push(input);
 		return _sum / (float) _cnt;
@@ -61,9 +74,12 @@ public:
 
 		/* push new one */
 		_d[_in] = d;
-		if (++_in >= _cap)
-			_in = 0;
 		++_cnt;
+		if (++_in >= _cap) {
+			_in = 0;
+			/* drop accumulated rounding error once per lap */
+			Resum();
+		}
 	}
 	void Pop() {
 		/* get the oldest */
@@ -84,6 +100,17 @@ public:
 	int GetCount() {
 		return _cnt;
 	}
+private:
+	void Resum() {
+		float sum = 0;
+		for (int i = 0; i < _cnt; ++i) {
+			int idx = _ou + i;
+			if (idx >= _cap)
+				idx -= _cap;
+			sum += _d[idx];
+		}
+		_sum = sum;
+	}
 };
 
 } // namespace  Signals
@@ -1,20 +1,26 @@
 #pragma once
 
-#include <time.h>
+#include <stdint.h>
 
 namespace ctre {
 namespace phoenix {
 
+/**
+ * Measures elapsed wall time since Start() using the monotonic clock.
+ * Construction starts it, so durations are never measured from the clock's
+ * arbitrary epoch.
+ */
 class Stopwatch {
 public:
+	Stopwatch();
 	void Start();
 	unsigned int DurationMs();
 	float Duration();
-	
+	int64_t DurationUs();
+	int64_t DurationNs();
+
 private:
-	unsigned long _t0 = 0;
-	unsigned long _t1 = 0;
-	float _scalar = 0.001f / CLOCKS_PER_SEC;
+	int64_t _t0; //!< MonotonicClock time of Start()
 };
 
 }}
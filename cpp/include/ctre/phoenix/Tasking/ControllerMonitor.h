@@ -0,0 +1,91 @@
+#pragma once
+
+#include <stdint.h>
+#include "ctre/phoenix/Tasking/ILoopable.h"
+#include "ctre/phoenix/Tasking/IProcessable.h"
+
+#ifndef CTR_EXCLUDE_WPILIB_CLASSES
+
+/* forward proto's */
+namespace frc {
+	class GenericHID;
+}
+
+namespace ctre {
+namespace phoenix {
+namespace tasking {
+
+/**
+ * Monitors every button of one controller at once.
+ *
+ * The whole button word is read once per Process(), press/release edges of
+ * all buttons are found with a single XOR, and only buttons with an edge are
+ * dispatched.  Each button can have one handler.  Optionally, a button change
+ * must be stable for a number of ticks before it is accepted (debounce), and
+ * buttons can report a long press once held for a number of ticks.
+ */
+class ControllerMonitor: public IProcessable, public ILoopable {
+public:
+	static const int kMaxButtons = 32;
+
+	enum ButtonEvent {
+		Pressed, Released, LongPressed,
+	};
+
+	class IButtonEventHandler {
+		public:
+			virtual ~IButtonEventHandler(){}
+			/**
+			 * @param idx one-based button index, as used by GetRawButton.
+			 * @param evt what happened to the button.
+			 */
+			virtual void OnButtonEvent(int idx, ButtonEvent evt) = 0;
+	};
+
+	ControllerMonitor(frc::GenericHID * controller);
+	ControllerMonitor(int port);
+	virtual ~ControllerMonitor() {	}
+
+	bool Add(int buttonIndex, IButtonEventHandler * handler,
+			bool reportLongPress = false);
+	void Remove(int buttonIndex);
+	void RemoveAll();
+	void SetDebounceTicks(int ticks);
+	void SetLongPressTicks(int ticks);
+
+	uint32_t GetButtons() const;
+	bool IsDown(int buttonIndex) const;
+
+	void Update(uint32_t rawButtons);
+
+	/* IProcessable */
+	virtual void Process();
+
+	/* ILoopable */
+	virtual void OnStart();
+	virtual void OnLoop();
+	virtual bool IsDone();
+	virtual void OnStop();
+
+private:
+	int _port;
+	IButtonEventHandler * _handlers[kMaxButtons]; //!< indexed by bit
+	uint32_t _handledMask = 0;
+	uint32_t _longPressMask = 0;
+
+	uint32_t _state = 0; //!< debounced button word
+	uint32_t _pending = 0; //!< bits whose raw value differs from _state
+	uint8_t _debounceCnt[kMaxButtons];
+	int _debounceTicks = 0;
+
+	uint32_t _longFired = 0; //!< held buttons that already reported long press
+	uint16_t _heldTicks[kMaxButtons];
+	int _longPressTicks = 50;
+
+	void Init();
+	void Dispatch(uint32_t bits, ButtonEvent evt);
+};
+}
+}
+}
+#endif // CTR_EXCLUDE_WPILIB_CLASSES
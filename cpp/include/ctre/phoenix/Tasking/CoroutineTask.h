@@ -0,0 +1,333 @@
+#pragma once
+
+/*
+ * Coroutine based ILoopable, requires C++20 coroutine support.
+ * Compiles to nothing on older toolchains.
+ *
+ * Example:
+ *
+ *	CoroutineTask Auton(CoroutineArena & arena, TalonSRX & elevator) {
+ *		elevator.Set(ControlMode::Position, 4096);
+ *		co_await WaitUntil([&] {return elevator.GetClosedLoopError(0) < 100;});
+ *		co_await RunLoopable(driveForward);	// any existing ILoopable
+ *		co_await WaitTicks(50);
+ *	}
+ *
+ *	StaticCoroutineArena<4096> arena;
+ *	CoroutineTask auton = Auton(arena, elevator);
+ *	sequentialScheduler.Add(&auton);
+ *
+ * The arena must be the first parameter of the coroutine, the frame is then
+ * carved out of it instead of the heap.  Note GCC 12 reports a false
+ * -Wmismatched-new-delete for such coroutines in unoptimized builds.
+ */
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#if __has_include(<coroutine>)
+
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <new>
+#include <utility>
+#include "ctre/phoenix/Tasking/ILoopable.h"
+
+namespace ctre {
+namespace phoenix {
+namespace tasking {
+
+/**
+ * Bump allocator for coroutine frames.  Memory is reclaimed once every frame
+ * allocated from it has been destroyed, so typically one arena is used per
+ * scheduler and its routines are created together.
+ */
+class CoroutineArena {
+public:
+	CoroutineArena(void * buffer, std::size_t capacity) :
+			_buffer(static_cast<unsigned char*>(buffer)), _capacity(capacity) {
+	}
+	CoroutineArena(CoroutineArena const&) = delete;
+	CoroutineArena& operator=(CoroutineArena const&) = delete;
+
+	/** @return block aligned to alignof(std::max_align_t), or nullptr */
+	void * Allocate(std::size_t size) {
+		const std::uintptr_t align = alignof(std::max_align_t);
+		/* align the address itself, the buffer may not be aligned */
+		std::uintptr_t base = reinterpret_cast<std::uintptr_t>(_buffer);
+		std::size_t start = ((base + _used + align - 1) & ~(align - 1)) - base;
+		if (start + size > _capacity)
+			return nullptr;
+		_used = start + size;
+		++_live;
+		return _buffer + start;
+	}
+	void Free(void * ptr) {
+		(void) ptr;
+		if (--_live == 0)
+			_used = 0;
+	}
+	std::size_t GetUsed() const {
+		return _used;
+	}
+	std::size_t GetCapacity() const {
+		return _capacity;
+	}
+private:
+	unsigned char * _buffer;
+	std::size_t _capacity;
+	std::size_t _used = 0;
+	int _live = 0;
+};
+
+/** Arena with inline storage. */
+template<std::size_t Bytes>
+class StaticCoroutineArena: public CoroutineArena {
+public:
+	StaticCoroutineArena() :
+			CoroutineArena(_storage, Bytes) {
+	}
+private:
+	alignas(std::max_align_t) unsigned char _storage[Bytes];
+};
+
+/**
+ * ILoopable that runs a coroutine.  Each OnLoop() polls whatever the
+ * coroutine is waiting on and resumes it once that is satisfied.  IsDone()
+ * is true once the coroutine returns, throws, is stopped, or if its frame
+ * could not be allocated.
+ *
+ * OnStop() ends the routine: the awaitable is cancelled and the frame is
+ * destroyed, so a later OnStart() does not resume past a wait that was never
+ * satisfied.  Create a new CoroutineTask to run the routine again.
+ */
+class CoroutineTask: public ILoopable {
+public:
+	struct promise_type {
+		/** returns true when the awaited condition is satisfied */
+		bool (*poll)(void*) = nullptr;
+		void * pollCtx = nullptr;
+		/** called from OnStop() to abandon whatever is being awaited */
+		void (*cancel)(void*) = nullptr;
+		/** exception that escaped the coroutine body, ends the task */
+		std::exception_ptr exception;
+
+		/** arena pointer ahead of the frame, padded to keep the frame aligned */
+		static const std::size_t kPrefix = (sizeof(CoroutineArena*)
+				+ alignof(std::max_align_t) - 1)
+				& ~(alignof(std::max_align_t) - 1);
+
+		static void * operator new(std::size_t size) = delete;
+		template<typename ... Args>
+		static void * operator new(std::size_t size, CoroutineArena & arena,
+				Args&...) noexcept {
+			void * mem = arena.Allocate(size + kPrefix);
+			if (mem == nullptr)
+				return nullptr;
+			/* remember the arena ahead of the frame for delete */
+			*static_cast<CoroutineArena**>(mem) = &arena;
+			return static_cast<unsigned char*>(mem) + kPrefix;
+		}
+		static void operator delete(void * ptr, std::size_t size) {
+			(void) size;
+			unsigned char * mem = static_cast<unsigned char*>(ptr) - kPrefix;
+			(*reinterpret_cast<CoroutineArena**>(mem))->Free(mem);
+		}
+		static CoroutineTask get_return_object_on_allocation_failure() {
+			return CoroutineTask();
+		}
+
+		CoroutineTask get_return_object() {
+			return CoroutineTask(
+					std::coroutine_handle<promise_type>::from_promise(*this));
+		}
+		std::suspend_always initial_suspend() noexcept {
+			return {};
+		}
+		std::suspend_always final_suspend() noexcept {
+			return {};
+		}
+		void return_void() {
+		}
+		void unhandled_exception() {
+			exception = std::current_exception();
+		}
+	};
+	typedef std::coroutine_handle<promise_type> handle_type;
+
+	CoroutineTask() {
+	}
+	explicit CoroutineTask(handle_type handle) :
+			_handle(handle) {
+	}
+	CoroutineTask(CoroutineTask && rhs) noexcept :
+			_handle(std::exchange(rhs._handle, nullptr)), _exception(
+					std::move(rhs._exception)) {
+	}
+	CoroutineTask& operator=(CoroutineTask && rhs) noexcept {
+		if (this != &rhs) {
+			Destroy();
+			_handle = std::exchange(rhs._handle, nullptr);
+			_exception = std::move(rhs._exception);
+		}
+		return *this;
+	}
+	CoroutineTask(CoroutineTask const&) = delete;
+	CoroutineTask& operator=(CoroutineTask const&) = delete;
+	virtual ~CoroutineTask() {
+		Destroy();
+	}
+
+	/* ILoopable */
+	virtual void OnStart() {
+	}
+	virtual void OnLoop() {
+		if (!_handle || _handle.done())
+			return;
+		promise_type & p = _handle.promise();
+		if (p.poll == nullptr || p.poll(p.pollCtx)) {
+			p.poll = nullptr;
+			p.cancel = nullptr;
+			_resuming = true;
+			_handle.resume();
+			_resuming = false;
+			if (_handle.done() && p.exception)
+				_exception = p.exception;
+			/* stopped from inside the body, destroy now that it is suspended */
+			if (_stopRequested)
+				Destroy();
+		}
+	}
+	virtual bool IsDone() {
+		return !_handle || _handle.done();
+	}
+	virtual void OnStop() {
+		if (!_handle)
+			return;
+		promise_type & p = _handle.promise();
+		if (p.cancel != nullptr)
+			p.cancel(p.pollCtx);
+		p.cancel = nullptr;
+		p.poll = nullptr;
+		p.pollCtx = nullptr;
+		/* the awaitable was abandoned, the frame must never be resumed */
+		if (_resuming)
+			_stopRequested = true;
+		else
+			Destroy();
+	}
+	/** @return exception thrown by the coroutine body, or null */
+	std::exception_ptr GetException() const {
+		return _exception;
+	}
+
+private:
+	handle_type _handle = nullptr;
+	std::exception_ptr _exception;
+	bool _resuming = false;
+	bool _stopRequested = false;
+
+	void Destroy() {
+		if (_handle)
+			_handle.destroy();
+		_handle = nullptr;
+		_stopRequested = false;
+	}
+};
+
+/**
+ * co_await WaitUntil(predicate) suspends until predicate() returns true.
+ * The predicate is checked once per OnLoop().
+ */
+template<typename Predicate>
+class WaitUntil {
+public:
+	explicit WaitUntil(Predicate pred) :
+			_pred(std::move(pred)) {
+	}
+	bool await_ready() {
+		return _pred();
+	}
+	void await_suspend(CoroutineTask::handle_type handle) {
+		CoroutineTask::promise_type & p = handle.promise();
+		p.poll = &Poll;
+		p.pollCtx = this;
+	}
+	void await_resume() {
+	}
+private:
+	Predicate _pred;
+
+	static bool Poll(void * ctx) {
+		return static_cast<WaitUntil*>(ctx)->_pred();
+	}
+};
+
+/**
+ * co_await WaitTicks(n) suspends for n calls of OnLoop().
+ */
+class WaitTicks {
+public:
+	explicit WaitTicks(int ticks) :
+			_remaining(ticks) {
+	}
+	bool await_ready() {
+		return _remaining <= 0;
+	}
+	void await_suspend(CoroutineTask::handle_type handle) {
+		CoroutineTask::promise_type & p = handle.promise();
+		p.poll = &Poll;
+		p.pollCtx = this;
+	}
+	void await_resume() {
+	}
+private:
+	int _remaining;
+
+	static bool Poll(void * ctx) {
+		return --static_cast<WaitTicks*>(ctx)->_remaining <= 0;
+	}
+};
+
+/**
+ * co_await RunLoopable(loop) runs an existing ILoopable to completion:
+ * OnStart, then OnLoop each tick until IsDone, then OnStop.
+ */
+class RunLoopable {
+public:
+	explicit RunLoopable(ILoopable & loop) :
+			_loop(loop) {
+	}
+	bool await_ready() {
+		return false;
+	}
+	void await_suspend(CoroutineTask::handle_type handle) {
+		CoroutineTask::promise_type & p = handle.promise();
+		p.poll = &Poll;
+		p.pollCtx = this;
+		p.cancel = &Cancel;
+		_loop.OnStart();
+	}
+	void await_resume() {
+	}
+private:
+	ILoopable & _loop;
+
+	static bool Poll(void * ctx) {
+		ILoopable & loop = static_cast<RunLoopable*>(ctx)->_loop;
+		loop.OnLoop();
+		if (!loop.IsDone())
+			return false;
+		loop.OnStop();
+		return true;
+	}
+	static void Cancel(void * ctx) {
+		static_cast<RunLoopable*>(ctx)->_loop.OnStop();
+	}
+};
+
+} // namespace tasking
+} // namespace phoenix
+} // namespace ctre
+
+#endif // __has_include(<coroutine>)
+#endif // __cpp_impl_coroutine
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <stdint.h>
+#include <atomic>
+#include "ctre/phoenix/Tasking/ILoopable.h"
+
+namespace ctre {
+namespace phoenix {
+namespace tasking {
+
+/**
+ * Times OnStart/OnLoop/OnStop calls of loopables on behalf of a scheduler.
+ * Give one to a scheduler with SetProfiler() to see which loopable is eating
+ * the loop budget.  Loopables are identified by slot, which is the slot of
+ * their handle (ConcurrentScheduler::GetSlot) or the index they were added
+ * with (SequentialScheduler).
+ *
+ * Each slot records call count, min/mean/max, overruns and a quarter-octave
+ * histogram (for p99) per callback.  Counters are atomics updated by the
+ * scheduler's thread only, so GetStats()/Dump() can be called from any thread
+ * without locking.  Slots at or beyond the capacity are called untimed.
+ */
+class LoopableProfiler {
+public:
+	static const int kHistogramBins = 128; //!< 4 bins per power of two ns
+
+	struct CallStats {
+		uint32_t calls;
+		uint32_t overruns; //!< calls longer than the overrun threshold
+		uint32_t minUs;
+		uint32_t meanUs;
+		uint32_t p99Us; //!< upper edge of the 99th percentile bin
+		uint32_t maxUs;
+	};
+	struct Stats {
+		ILoopable * loopable; //!< null if slot was never called
+		CallStats onStart;
+		CallStats onLoop;
+		CallStats onStop;
+	};
+
+	LoopableProfiler(int capacity = 32, int overrunThresholdUs = 1000);
+	~LoopableProfiler();
+	LoopableProfiler(LoopableProfiler const&) = delete;
+	LoopableProfiler& operator=(LoopableProfiler const&) = delete;
+
+	void OnStart(int slot, ILoopable * loop);
+	void OnLoop(int slot, ILoopable * loop);
+	void OnStop(int slot, ILoopable * loop);
+
+	int GetCapacity() const;
+	bool GetStats(int slot, Stats & toFill) const;
+	int Dump(char * buffer, int capacity) const;
+	void Reset();
+	void Reset(int slot);
+
+private:
+	struct Counters {
+		std::atomic<uint32_t> calls;
+		std::atomic<uint32_t> overruns;
+		std::atomic<uint32_t> minNs;
+		std::atomic<uint32_t> maxNs;
+		std::atomic<uint64_t> sumNs;
+		std::atomic<uint32_t> histogram[kHistogramBins];
+	};
+	struct Slot {
+		std::atomic<ILoopable*> loop;
+		Counters onStart;
+		Counters onLoop;
+		Counters onStop;
+	};
+	Slot * _slots;
+	int _capacity;
+	uint32_t _overrunThresholdNs;
+
+	void Record(Counters & counters, int64_t elapsedNs);
+	static void ResetCounters(Counters & counters);
+	static void FillCallStats(const Counters & counters, CallStats & toFill);
+};
+
+} // namespace tasking
+} // namespace phoenix
+} // namespace ctre
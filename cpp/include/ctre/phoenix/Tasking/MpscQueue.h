@@ -0,0 +1,108 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include <memory>
+
+namespace ctre {
+namespace phoenix {
+namespace tasking {
+
+/**
+ * Bounded multi-producer single-consumer queue.
+ *
+ * Any number of threads may TryPush() concurrently, one thread TryPop()s.
+ * Neither side takes a lock or waits on the other, a push into a full queue
+ * fails immediately instead of blocking.  Each slot carries a sequence
+ * number telling producers and the consumer whose turn it is, so a producer
+ * only contends with other producers on a single compare-and-swap.
+ *
+ * @param T trivially copyable element type.
+ */
+template<typename T>
+class MpscQueue {
+public:
+	/**
+	 * @param capacity maximum number of queued elements, rounded up to a
+	 *                 power of two.  Storage is allocated here.
+	 */
+	explicit MpscQueue(size_t capacity) {
+		size_t cap = 2;
+		while (cap < capacity)
+			cap <<= 1;
+		_mask = cap - 1;
+		_cells.reset(new Cell[cap]);
+		for (size_t i = 0; i < cap; ++i)
+			_cells[i].seq.store(i, std::memory_order_relaxed);
+		_enqueuePos.store(0, std::memory_order_relaxed);
+		_dequeuePos = 0;
+	}
+	MpscQueue(MpscQueue const&) = delete;
+	MpscQueue& operator=(MpscQueue const&) = delete;
+
+	/**
+	 * Safe to call from any thread.
+	 * @return false if the queue is full.
+	 */
+	bool TryPush(const T & value) {
+		size_t pos = _enqueuePos.load(std::memory_order_relaxed);
+		for (;;) {
+			Cell & cell = _cells[pos & _mask];
+			size_t seq = cell.seq.load(std::memory_order_acquire);
+			intptr_t dif = (intptr_t) seq - (intptr_t) pos;
+			if (dif == 0) {
+				/* slot is free for this position, try to claim it */
+				if (_enqueuePos.compare_exchange_weak(pos, pos + 1,
+						std::memory_order_relaxed))
+					break;
+			} else if (dif < 0) {
+				/* consumer hasn't freed this slot yet */
+				return false;
+			} else {
+				/* another producer claimed it, catch up */
+				pos = _enqueuePos.load(std::memory_order_relaxed);
+			}
+		}
+		Cell & cell = _cells[pos & _mask];
+		cell.value = value;
+		cell.seq.store(pos + 1, std::memory_order_release);
+		return true;
+	}
+	/**
+	 * Consumer thread only.
+	 * @return false if the queue is empty.
+	 */
+	bool TryPop(T & value) {
+		Cell & cell = _cells[_dequeuePos & _mask];
+		size_t seq = cell.seq.load(std::memory_order_acquire);
+		if (seq != _dequeuePos + 1)
+			return false;
+		value = cell.value;
+		/* hand the slot back to producers one lap later */
+		cell.seq.store(_dequeuePos + _mask + 1, std::memory_order_release);
+		++_dequeuePos;
+		return true;
+	}
+	size_t GetCapacity() const {
+		return _mask + 1;
+	}
+
+private:
+	struct Cell {
+		std::atomic<size_t> seq;
+		T value;
+	};
+	std::unique_ptr<Cell[]> _cells;
+	size_t _mask;
+	/* keep producer and consumer positions off each other's cache line,
+	 * padded rather than alignas so C++14 new doesn't need over-alignment */
+	char _pad0[64];
+	std::atomic<size_t> _enqueuePos;
+	char _pad1[64];
+	size_t _dequeuePos;
+};
+
+} // namespace tasking
+} // namespace phoenix
+} // namespace ctre
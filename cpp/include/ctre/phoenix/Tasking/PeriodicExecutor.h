@@ -0,0 +1,82 @@
+#pragma once
+
+#include <stdint.h>
+#include <atomic>
+#include <thread>
+#include "ctre/phoenix/Tasking/ILoopable.h"
+
+namespace ctre {
+namespace phoenix {
+namespace tasking {
+
+/**
+ * Drives an ILoopable (typically a scheduler) at a fixed rate on a dedicated
+ * thread.  Each tick sleeps until an absolute deadline, so timing errors do
+ * not accumulate.  The thread can optionally run with SCHED_FIFO priority and
+ * be pinned to a CPU.
+ *
+ * Wake-up jitter (lateness past the deadline), overruns (OnLoop ran past the
+ * next deadline) and OnLoop execution times are recorded, and can be read from
+ * any thread while running.
+ */
+class PeriodicExecutor {
+public:
+	static const int kHistogramBins = 32;
+
+	struct Stats {
+		uint32_t ticks;
+		uint32_t overruns; //!< ticks whose OnLoop ran past the next deadline
+		uint32_t missedDeadlines; //!< deadlines skipped because of overruns
+		uint32_t minJitterUs;
+		uint32_t maxJitterUs;
+		uint32_t meanJitterUs;
+		uint32_t maxExecUs;
+		uint32_t meanExecUs;
+		uint32_t histogramBinWidthUs;
+		uint32_t jitterHistogram[kHistogramBins]; //!< last bin includes everything above
+		uint32_t execHistogram[kHistogramBins]; //!< last bin includes everything above
+	};
+
+	PeriodicExecutor(ILoopable * loopable, int periodUs);
+	~PeriodicExecutor();
+	PeriodicExecutor(PeriodicExecutor const&) = delete;
+	PeriodicExecutor& operator=(PeriodicExecutor const&) = delete;
+
+	void SetRealtimePriority(int priority);
+	void SetCpuAffinity(int cpu);
+	bool Start();
+	void Stop();
+	bool IsRunning() const;
+
+	void GetStats(Stats & toFill) const;
+	void ResetStats();
+
+private:
+	ILoopable * _loopable;
+	int64_t _periodNs;
+	int _priority = 0; //!< 0 is normal scheduling
+	int _cpu = -1; //!< -1 is no affinity
+
+	std::thread _thread;
+	std::atomic<bool> _running;
+
+	uint32_t _binWidthUs;
+	std::atomic<uint32_t> _ticks;
+	std::atomic<uint32_t> _overruns;
+	std::atomic<uint32_t> _missedDeadlines;
+	std::atomic<uint32_t> _minJitterUs;
+	std::atomic<uint32_t> _maxJitterUs;
+	std::atomic<uint64_t> _sumJitterUs;
+	std::atomic<uint32_t> _maxExecUs;
+	std::atomic<uint64_t> _sumExecUs;
+	std::atomic<uint32_t> _jitterHistogram[kHistogramBins];
+	std::atomic<uint32_t> _execHistogram[kHistogramBins];
+
+	void Run();
+	void ApplyThreadSettings();
+	void Record(uint32_t jitterUs, uint32_t execUs);
+};
+
+} // namespace tasking
+} // namespace phoenix
+} // namespace ctre
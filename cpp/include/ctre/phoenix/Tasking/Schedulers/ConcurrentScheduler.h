@@ -1,27 +1,91 @@
 #pragma once
 
+#include <atomic>
+#include <unordered_map>
 #include <vector>
 #include "ctre/phoenix/Tasking/ILoopable.h"
 #include "ctre/phoenix/Tasking/IProcessable.h"
+#include "ctre/phoenix/Tasking/LoopableProfiler.h"
+#include "ctre/phoenix/Tasking/MpscQueue.h"
+#include "ctre/phoenix/Tasking/TimerWheel.h"
 
 namespace ctre {
 namespace phoenix {
 namespace tasking {
 namespace schedulers {
 
-class ConcurrentScheduler: public ILoopable, public IProcessable {
+/**
+ * Calls OnLoop() of every started loopable each Process().
+ *
+ * Add() returns a handle so loopables can be started/stopped in O(1).  A
+ * handle is a slot index plus a generation.  Slots of removed loopables are
+ * recycled, so storage stays bounded by the most loopables added at once,
+ * but the generation changes so a stale handle is ignored rather than
+ * reaching the new occupant.
+ *
+ * Started loopables are kept in a contiguous list that Process() walks
+ * directly.  Stopping a loopable between ticks moves the last started
+ * loopable into its place, so call order among started loopables is not
+ * preserved across Stop().  Stopping during Process() only leaves a hole that
+ * is closed after the tick, so every loopable still started gets its turn.
+ * A loopable restarted during Process() after it already ran is not run a
+ * second time that tick.
+ *
+ * A started loopable can Sleep() for a number of ticks instead of polling a
+ * timer in OnLoop().  It is taken off the started list (without OnStop) and
+ * put back when its timer expires, so it costs nothing while asleep.
+ *
+ * Callbacks can be timed per loopable by giving it a LoopableProfiler, the
+ * handle's slot (see GetSlot) is used as the profiler slot, and is cleared
+ * when recycled.
+ *
+ * Only the Post functions may be called from other threads.  They queue the
+ * command without blocking, and the scheduler's thread applies queued
+ * commands at the start of the next Process().  Until then the scheduler
+ * may still call a loopable passed to PostRemove(), so it must outlive that
+ * Process().
+ */
+class ConcurrentScheduler: public ILoopable,
+		public IProcessable,
+		public TimerWheel::IExpiredHandler {
 public:
-	std::vector<ILoopable*> _loops;
-	std::vector<bool> _enabs;
+	typedef int Handle;
+	static const int kSlotBits = 16; //!< low bits of a handle
+	static const int kMaxSlots = 1 << kSlotBits;
 
-	ConcurrentScheduler();
+	/** @return profiler slot / storage index of a handle. */
+	static int GetSlot(Handle handle) {
+		return handle & (kMaxSlots - 1);
+	}
+
+	ConcurrentScheduler(int commandQueueCapacity = 64);
 	virtual ~ConcurrentScheduler();
-	void Add(ILoopable *aLoop, bool enable = true);
+	Handle Add(ILoopable *aLoop, bool enable = true);
+	void Remove(ILoopable *toRemove);
+	void Remove(Handle handle);
 	void RemoveAll();
 	void Start(ILoopable *toStart);
 	void Stop(ILoopable *toStop);
+	void Start(Handle handle);
+	void Stop(Handle handle);
 	void StartAll();
 	void StopAll();
+	bool IsStarted(Handle handle) const;
+	int GetCount() const;
+	int GetStartedCount() const;
+	void SetProfiler(LoopableProfiler * profiler);
+	void Sleep(Handle handle, int ticks);
+	void Wake(Handle handle);
+	bool IsSleeping(Handle handle) const;
+
+	bool PostAdd(ILoopable *aLoop, bool enable = true);
+	bool PostStart(ILoopable *toStart);
+	bool PostStop(ILoopable *toStop);
+	bool PostRemove(ILoopable *toRemove);
+	uint32_t GetDroppedCommandCount() const;
+
+	//TimerWheel::IExpiredHandler
+	void OnTimerExpired(int id);
 
 	//IProcessable
 	void Process();
@@ -32,6 +96,43 @@ public:
 	void OnLoop();
 	void OnStop();
 	bool IsDone();
+
+private:
+	enum CommandType {
+		CmdAdd, CmdStart, CmdStop, CmdRemove,
+	};
+	struct Command {
+		CommandType type;
+		ILoopable * loop;
+		bool enable;
+	};
+	struct Entry {
+		ILoopable * loop; //!< null once removed
+		int activeIdx; //!< position in _active, -1 if stopped
+		int generation; //!< high bits of this slot's current handle
+		uint32_t lastTick; //!< value of _tick when OnLoop was last called
+	};
+	std::vector<Entry> _entries; //!< indexed by slot
+	std::vector<int> _freeSlots; //!< slots of removed loopables
+	std::unordered_map<ILoopable*, Handle> _handles;
+	std::vector<ILoopable*> _active; //!< started loopables, null is a hole
+	std::vector<int> _activeSlots; //!< slot of each _active element
+	bool _iterating = false; //!< Process() is walking _active
+	int _holes = 0; //!< stopped during this Process(), closed after it
+	uint32_t _tick = 0; //!< number of Process() calls
+	LoopableProfiler * _profiler = nullptr;
+	TimerWheel _wheel; //!< wake-ups of sleeping loopables, id is slot
+	MpscQueue<Command> _commands;
+	std::atomic<uint32_t> _droppedCommands;
+
+	int Find(Handle handle) const;
+	void Enable(int slot);
+	void Disable(int slot);
+	void CloseHoles();
+	void CallOnStart(int slot);
+	void CallOnStop(int slot);
+	bool Post(CommandType type, ILoopable * loop, bool enable);
+	void ApplyCommands();
 };
 }
 }
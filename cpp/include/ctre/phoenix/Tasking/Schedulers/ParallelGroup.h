@@ -0,0 +1,75 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include "ctre/phoenix/Tasking/ILoopable.h"
+#include "ctre/phoenix/Tasking/Schedulers/ParallelScheduler.h"
+
+namespace ctre {
+namespace phoenix {
+namespace tasking {
+namespace schedulers {
+
+/**
+ * Runs a set of loopables side by side as one loopable, so it can be placed
+ * in a SequentialScheduler (or nested in another group), e.g. drive while
+ * raising the elevator, then shoot.
+ *
+ * Each OnLoop() calls OnLoop() of every child that is not yet done.  A child
+ * is stopped as soon as its IsDone() is true, and the group is done when:
+ *  - All: every child is done.
+ *  - Race: any child is done, the others are stopped.
+ *  - Deadline: the deadline child is done, the others are stopped.
+ *
+ * With worker threads, children's OnLoop() calls of a tick are spread over a
+ * ParallelScheduler and joined before OnLoop() returns.  OnStart/OnStop of
+ * children always run on the calling thread.  Children must be added before
+ * the group is started.
+ *
+ * Each group given worker threads owns its own pool, so nesting such groups
+ * (or placing one in a ParallelScheduler) multiplies the thread count.  Idle
+ * workers sleep rather than spin, but nested groups should normally be given
+ * 0 worker threads and let the outermost pool provide the parallelism.
+ */
+class ParallelGroup: public ILoopable {
+public:
+	enum Mode {
+		All, Race, Deadline,
+	};
+
+	ParallelGroup(Mode mode = All, int workerThreads = 0);
+	virtual ~ParallelGroup();
+	ParallelGroup(ParallelGroup const&) = delete;
+	ParallelGroup& operator=(ParallelGroup const&) = delete;
+
+	void Add(ILoopable *aLoop, bool isDeadline = false);
+	void RemoveAll();
+	Mode GetMode() const;
+	int GetRunningCount() const;
+
+	//ILoopable
+	void OnStart();
+	void OnLoop();
+	void OnStop();
+	bool IsDone();
+
+private:
+	struct Child {
+		ILoopable * loop;
+		bool running;
+	};
+	Mode _mode;
+	std::vector<Child> _children;
+	int _deadlineIdx = -1;
+	int _running = 0;
+	bool _done = true;
+	std::unique_ptr<ParallelScheduler> _pool; //!< null to run on caller's thread
+
+	void StopChild(Child & child);
+	void StopRemaining();
+};
+
+} // namespace schedulers
+} // namespace tasking
+} // namespace phoenix
+} // namespace ctre
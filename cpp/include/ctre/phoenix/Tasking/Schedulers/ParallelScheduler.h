@@ -0,0 +1,101 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "ctre/phoenix/Tasking/ILoopable.h"
+#include "ctre/phoenix/Tasking/IProcessable.h"
+
+namespace ctre {
+namespace phoenix {
+namespace tasking {
+namespace schedulers {
+
+/**
+ * Parallel variant of ConcurrentScheduler.
+ * Each Process() call runs OnLoop() of every enabled loopable exactly once,
+ * spread over a small pool of worker threads plus the calling thread, and
+ * returns once all of them are finished.  Tick time is then set by the
+ * longest dependency chain rather than the sum of all loopables.
+ *
+ * Workers each own a queue of ready loopables and steal from each other
+ * when idle, and sleep on a condition variable when there is nothing left to
+ * steal.  Optional dependency edges force one loopable's OnLoop to finish
+ * before another's starts within the same tick, edges that would form a
+ * cycle are rejected.  A start queue can be chosen per loopable, see Add().
+ *
+ * OnStart/OnStop and Add/Start/Stop run on the calling thread and must not be
+ * called while Process() is running.
+ */
+class ParallelScheduler: public ILoopable, public IProcessable {
+public:
+	ParallelScheduler(int workerThreads = 2);
+	virtual ~ParallelScheduler();
+	ParallelScheduler(ParallelScheduler const&) = delete;
+	ParallelScheduler& operator=(ParallelScheduler const&) = delete;
+
+	void Add(ILoopable *aLoop, bool enable = true, int startQueue = -1);
+	bool AddDependency(ILoopable *first, ILoopable *then);
+	void RemoveAll();
+	void Start(ILoopable *toStart);
+	void Stop(ILoopable *toStop);
+	void StartAll();
+	void StopAll();
+
+	//IProcessable
+	void Process();
+
+	//ILoopable
+	void OnStart();
+	void OnLoop();
+	void OnStop();
+	bool IsDone();
+
+private:
+	struct Node {
+		ILoopable * loop;
+		bool enabled;
+		int startQueue; //!< -1 for round robin
+		std::vector<int> successors;
+		std::atomic<int> pending; //!< predecessors not yet finished this tick
+	};
+	struct WorkQueue {
+		std::mutex lock;
+		std::deque<int> ready;
+	};
+
+	std::deque<Node> _nodes;
+	int _queueCount; //!< workers plus the calling thread
+	std::unique_ptr<WorkQueue[]> _queues;
+	std::vector<std::thread> _workers;
+
+	std::mutex _tickLock;
+	std::condition_variable _tickStart;
+	uint32_t _tickGeneration = 0;
+	bool _quit = false;
+	std::atomic<int> _remaining;
+
+	std::mutex _parkLock;
+	std::condition_variable _parked; //!< idle threads wait for work here
+	std::atomic<int> _readyCount; //!< loopables sitting in any queue
+	std::atomic<int> _sleepers; //!< threads waiting on _parked
+
+	int Find(ILoopable * loop) const;
+	bool Reaches(int from, int to) const;
+	void Push(int queueIdx, int nodeIdx);
+	bool TryPop(int queueIdx, int & nodeIdx);
+	bool TrySteal(int queueIdx, int & nodeIdx);
+	void Park();
+	void WakeParked(bool all);
+	void RunUntilTickDone(int queueIdx);
+	void WorkerMain(int queueIdx);
+};
+
+} // namespace schedulers
+} // namespace tasking
+} // namespace phoenix
+} // namespace ctre
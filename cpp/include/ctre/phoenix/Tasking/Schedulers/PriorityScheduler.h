@@ -0,0 +1,114 @@
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+#include "ctre/phoenix/Tasking/ILoopable.h"
+#include "ctre/phoenix/Tasking/IProcessable.h"
+
+namespace ctre {
+namespace phoenix {
+namespace tasking {
+namespace schedulers {
+
+/**
+ * Calls OnLoop() of every started loopable each Process(), highest priority
+ * first, within a per-tick time budget.
+ *
+ * Loopables at or above the critical priority always run.  Any other loopable
+ * is deferred to a later tick if its expected cost (its configured budget, or
+ * its measured average when none is given) no longer fits in what is left of
+ * the tick budget.  A loopable deferred for maxDeferTicks consecutive ticks
+ * is run anyway, so under sustained load low priority work still runs at a
+ * reduced rate instead of starving.
+ *
+ * Deferrals, forced runs and budget overruns are counted per loopable and the
+ * most recent ones are kept in a fixed size decision log.
+ */
+class PriorityScheduler: public ILoopable, public IProcessable {
+public:
+	typedef int Handle;
+	static const int kDecisionLogSize = 64;
+
+	enum Action {
+		Deferred, //!< skipped this tick, did not fit in remaining budget
+		ForcedRun, //!< ran despite not fitting, deferred too many times
+		Overran, //!< ran longer than its own budget
+	};
+	struct Decision {
+		uint32_t tick;
+		Handle handle;
+		Action action;
+		uint32_t tickElapsedUs; //!< time used in the tick when decided
+	};
+	struct LoopStats {
+		uint32_t runs;
+		uint32_t deferrals;
+		uint32_t forcedRuns;
+		uint32_t overruns;
+		uint32_t avgExecUs;
+		uint32_t maxExecUs;
+	};
+	struct TickStats {
+		uint32_t ticks;
+		uint32_t overBudgetTicks; //!< ticks that used more than the budget
+		uint32_t lastTickUs;
+		uint32_t maxTickUs;
+	};
+
+	PriorityScheduler(int tickBudgetUs, int criticalPriority = 100,
+			int maxDeferTicks = 10);
+	virtual ~PriorityScheduler();
+	Handle Add(ILoopable *aLoop, int priority, int budgetUs = 0,
+			bool enable = true);
+	void RemoveAll();
+	void Start(Handle handle);
+	void Stop(Handle handle);
+	void StartAll();
+	void StopAll();
+	bool IsStarted(Handle handle) const;
+	int GetCount() const;
+
+	void SetTickBudget(int tickBudgetUs);
+	void GetLoopStats(Handle handle, LoopStats & toFill) const;
+	void GetTickStats(TickStats & toFill) const;
+	int GetDecisions(Decision * toFill, int capacity) const;
+	void ResetStats();
+
+	//IProcessable
+	void Process();
+
+	//ILoopable
+	void OnStart();
+	void OnLoop();
+	void OnStop();
+	bool IsDone();
+
+private:
+	struct Entry {
+		ILoopable * loop;
+		int priority;
+		uint32_t budgetNs; //!< 0 to use measured average
+		bool enabled;
+		uint32_t avgExecNs; //!< filtered execution time
+		uint32_t consecutiveDeferrals;
+		LoopStats stats;
+	};
+	std::vector<Entry> _entries; //!< indexed by handle
+	std::vector<Handle> _order; //!< handles by descending priority
+	int _processIndex = -1; //!< position in _order being run, -1 outside Process()
+
+	int64_t _tickBudgetNs;
+	int _criticalPriority;
+	uint32_t _maxDeferTicks;
+
+	TickStats _tickStats;
+	Decision _log[kDecisionLogSize];
+	uint32_t _logCount = 0; //!< total decisions ever logged
+
+	void Log(Handle handle, Action action, int64_t tickElapsedNs);
+	void RunEntry(Handle handle, int64_t tickElapsedNs);
+};
+}
+}
+}
+}
@@ -3,6 +3,7 @@
 #include <vector>
 #include "ctre/phoenix/Tasking/ILoopable.h"
 #include "ctre/phoenix/Tasking/IProcessable.h"
+#include "ctre/phoenix/Tasking/LoopableProfiler.h"
 
 namespace ctre { namespace phoenix { namespace tasking { namespace schedulers {
 
@@ -21,6 +22,7 @@ public:
 	void RemoveAll();
 	void Start();
 	void Stop();
+	void SetProfiler(LoopableProfiler * profiler);
 
 	//IProcessable
 	void Process();
@@ -30,5 +32,11 @@ public:
 	void OnLoop();
 	void OnStop();
 	bool IsDone();
+
+private:
+	LoopableProfiler * _profiler = nullptr;
+
+	void CallOnStart(unsigned int idx);
+	void CallOnStop(unsigned int idx);
 };
 }}}}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+
+namespace ctre {
+namespace phoenix {
+namespace tasking {
+
+/**
+ * Hierarchical timer wheel counting in ticks.
+ *
+ * Timers are identified by a small non-negative id (e.g. a scheduler
+ * handle).  Schedule() and Cancel() are O(1).  Advance() moves time forward
+ * one tick and reports every timer that expires on it; timers further out
+ * sit in coarser levels and are cascaded down as time approaches, so the
+ * cost per tick does not depend on how many timers are pending.
+ *
+ * Four levels of 64 slots cover delays up to 2^24 ticks, longer delays are
+ * clamped.  Not thread-safe, use from the scheduler's thread.
+ */
+class TimerWheel {
+public:
+	static const int kSlotBits = 6;
+	static const int kSlots = 1 << kSlotBits;
+	static const int kLevels = 4;
+	static const uint32_t kMaxDelay = (1u << (kSlotBits * kLevels)) - 1;
+
+	class IExpiredHandler {
+		public:
+			virtual ~IExpiredHandler(){}
+			virtual void OnTimerExpired(int id) = 0;
+	};
+
+	TimerWheel();
+	TimerWheel(TimerWheel const&) = delete;
+	TimerWheel& operator=(TimerWheel const&) = delete;
+
+	void Schedule(int id, uint32_t delayTicks);
+	void Cancel(int id);
+	void CancelAll();
+	bool IsScheduled(int id) const;
+	uint32_t GetRemaining(int id) const;
+	int GetScheduledCount() const;
+	uint32_t GetNow() const;
+
+	void Advance(IExpiredHandler * handler);
+
+private:
+	struct Node {
+		int prev;
+		int next;
+		int * head; //!< list this node is on, null if not scheduled
+		uint32_t expiry;
+	};
+	std::vector<Node> _nodes; //!< indexed by id, grows on demand
+	int _slots[kLevels][kSlots]; //!< head node id of each slot, -1 if empty
+	uint32_t _now = 0;
+	int _scheduled = 0;
+
+	void Insert(int id);
+	void Unlink(int id);
+	void Cascade(int level);
+};
+
+} // namespace tasking
+} // namespace phoenix
+} // namespace ctre
@@ -0,0 +1,20 @@
+#pragma once
+
+namespace ctre {
+namespace phoenix {
+namespace telemetry {
+
+/**
+ * Fills in the variables behind a group of recorder signals.  The recorder
+ * calls Sample() on every added source at the start of each row.
+ */
+class ITelemetrySource {
+public:
+	virtual ~ITelemetrySource() {
+	}
+	virtual void Sample() = 0;
+};
+
+} // namespace telemetry
+} // namespace phoenix
+} // namespace ctre
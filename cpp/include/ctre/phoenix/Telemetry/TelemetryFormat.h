@@ -0,0 +1,112 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+namespace ctre {
+namespace phoenix {
+namespace telemetry {
+
+/**
+ * On-disk layout of a telemetry recording, shared by TelemetryRecorder and
+ * the offline decoder (cpp/tools/TelemetryDecode.cpp).  All integers are
+ * little endian.
+ *
+ * The file has a fixed size.  It starts with a FileHeader and one
+ * ColumnDesc per column, followed by a ring of blocks.  Each block holds up
+ * to rowsPerBlock rows stored column by column: a BlockHeader, a uint32
+ * byte length per column (timestamp column first), then each column's
+ * bytes.  Every value is the zigzag varint of its difference from the
+ * previous row of the same column, starting from 0 in each block, so every
+ * block decodes on its own.  When a block does not fit before the end of the
+ * file a kWrapMagic word is written (if there is room) and writing resumes
+ * at the start of the ring, overwriting the oldest blocks.  FileHeader::tail
+ * is the oldest complete block and FileHeader::head is where the next block
+ * goes.  The two are equal both when the ring is empty and when it is
+ * full, FileHeader::liveBlocks tells them apart and is how many blocks a
+ * reader walks from the tail.
+ */
+namespace format {
+
+static const char kFileMagic[8] = { 'C', 'T', 'R', 'T', 'L', 'M', '1', 0 };
+static const uint32_t kVersion = 2;
+static const uint32_t kBlockMagic = 0x4B4C4254; //!< "TBLK"
+static const uint32_t kWrapMagic = 0x50525754; //!< "TWRP"
+static const int kNameLength = 48;
+static const int kMaxVarintBytes = 10;
+
+/** how a column's stored integers map back to values */
+enum ColumnType {
+	Int = 0, //!< stored as is
+	Float = 1, //!< stored as value / resolution, rounded
+	Bool = 2, //!< 0 or 1
+};
+
+struct FileHeader {
+	char magic[8];
+	uint32_t version;
+	uint32_t columnCount; //!< not counting the timestamp column
+	uint32_t dataStart; //!< offset of the block ring
+	uint32_t dataEnd; //!< file size
+	uint32_t head; //!< offset the next block is written at
+	uint32_t tail; //!< offset of the oldest block
+	uint32_t rowsPerBlock;
+	uint32_t blockCount; //!< blocks written since the file was created
+	uint32_t liveBlocks; //!< blocks between tail and head
+	uint32_t reserved; //!< keeps the ColumnDescs 8 byte aligned
+};
+
+struct ColumnDesc {
+	char name[kNameLength];
+	uint32_t type; //!< ColumnType
+	uint32_t reserved;
+	double resolution;
+};
+
+struct BlockHeader {
+	uint32_t magic; //!< kBlockMagic
+	uint32_t sequence;
+	uint32_t rowCount;
+	uint32_t totalBytes; //!< including this header and the length table
+};
+
+inline uint32_t DataStart(uint32_t columnCount) {
+	uint32_t bytes = (uint32_t) (sizeof(FileHeader)
+			+ columnCount * sizeof(ColumnDesc));
+	return (bytes + 63) & ~63u;
+}
+inline uint64_t ZigZag(int64_t value) {
+	return ((uint64_t) value << 1) ^ (uint64_t) (value >> 63);
+}
+inline int64_t UnZigZag(uint64_t value) {
+	return (int64_t) (value >> 1) ^ -(int64_t) (value & 1);
+}
+/**
+ * @return bytes written, at most kMaxVarintBytes.
+ */
+inline int PutVarint(uint8_t * out, uint64_t value) {
+	int n = 0;
+	while (value >= 0x80) {
+		out[n++] = (uint8_t) (value | 0x80);
+		value >>= 7;
+	}
+	out[n++] = (uint8_t) value;
+	return n;
+}
+/**
+ * @return bytes read, 0 if the varint runs past end or is too long.
+ */
+inline int GetVarint(const uint8_t * in, const uint8_t * end, uint64_t & value) {
+	value = 0;
+	for (int n = 0; n < kMaxVarintBytes && in + n < end; ++n) {
+		value |= (uint64_t) (in[n] & 0x7F) << (7 * n);
+		if ((in[n] & 0x80) == 0)
+			return n + 1;
+	}
+	return 0;
+}
+
+} // namespace format
+} // namespace telemetry
+} // namespace phoenix
+} // namespace ctre
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+#include "ctre/phoenix/ErrorCode.h"
+#include "ctre/phoenix/Tasking/IProcessable.h"
+#include "ctre/phoenix/Telemetry/ITelemetrySource.h"
+#include "ctre/phoenix/Telemetry/TelemetryFormat.h"
+
+namespace ctre {
+namespace phoenix {
+namespace telemetry {
+
+/**
+ * Records a row of signals every loop into a fixed size, memory mapped file
+ * for analysis after the match.  Decode recordings with
+ * cpp/tools/TelemetryDecode.cpp.
+ *
+ *	TelemetryRecorder recorder;
+ *	double ypr[3];
+ *	recorder.AddSignal("pigeon.yaw", &ypr[0], 0.01);
+ *	recorder.AddSignal("drive.left.vel", &leftVel);
+ *	recorder.Open("/home/lvuser/telemetry.bin");
+ *	...
+ *	pigeon.GetYawPitchRoll(ypr);
+ *	leftVel = leftTalon.GetSelectedSensorVelocity(0);
+ *	recorder.Process();
+ *
+ * Each signal is bound to the variable holding it, and Record() samples
+ * every bound variable.  Rows are encoded column by column as delta +
+ * varint into preallocated buffers, so recording is a few arithmetic
+ * operations per signal with no allocation or system call.  Every
+ * rowsPerBlock rows the block is copied into the mapped file, which the
+ * kernel writes back in the background.  The file is a ring: once full, the
+ * oldest blocks are overwritten.  Floating point signals are stored as
+ * integer multiples of their resolution.
+ *
+ * Signals must be added before Open(), the layout is fixed for the file.
+ * Device state can be recorded with the ready made sources in
+ * TelemetrySources.h, which add their own signals and read the device each
+ * row.
+ */
+class TelemetryRecorder: public ctre::phoenix::tasking::IProcessable {
+public:
+	static const int kMaxColumns = 256;
+
+	TelemetryRecorder(int rowsPerBlock = 250);
+	virtual ~TelemetryRecorder();
+	TelemetryRecorder(TelemetryRecorder const&) = delete;
+	TelemetryRecorder& operator=(TelemetryRecorder const&) = delete;
+
+	int AddSignal(const char * name, const int32_t * source);
+	int AddSignal(const char * name, const uint32_t * source);
+	int AddSignal(const char * name, const bool * source);
+	int AddSignal(const char * name, const float * source,
+			double resolution = 0.001);
+	int AddSignal(const char * name, const double * source,
+			double resolution = 0.001);
+	bool AddSource(ITelemetrySource * source);
+
+	ErrorCode Open(const char * path, int fileBytes = 16 * 1024 * 1024);
+	void Record();
+	void Record(int64_t timestampUs);
+	void Flush();
+	void Close();
+
+	bool IsOpen() const;
+	int GetColumnCount() const;
+	uint32_t GetBlockCount() const;
+
+	/* IProcessable */
+	virtual void Process();
+
+private:
+	enum SourceType {
+		SourceInt32, SourceUInt32, SourceBool, SourceFloat, SourceDouble,
+	};
+	struct Column {
+		const void * source;
+		SourceType sourceType;
+		format::ColumnType type;
+		double invResolution;
+		double resolution;
+		char name[format::kNameLength];
+	};
+
+	std::vector<Column> _columns;
+	std::vector<ITelemetrySource *> _sources;
+	int _rowsPerBlock;
+
+	/* column buffers, column c (timestamp is column 0) owns
+	 * [c * _stride, (c + 1) * _stride) */
+	std::vector<uint8_t> _buffer;
+	std::vector<uint32_t> _used; //!< bytes used per column
+	std::vector<int64_t> _prev; //!< last value per column in this block
+	int _stride = 0;
+	int _rows = 0;
+
+	int _fd = -1;
+	uint8_t * _map = nullptr;
+	uint32_t _mapBytes = 0;
+	bool _wrapped = false; //!< old blocks remain between head and end
+	uint32_t _lapBlocks = 0; //!< blocks written since head last wrapped
+
+	int Add(const char * name, const void * source, SourceType sourceType,
+			format::ColumnType type, double resolution);
+	format::FileHeader & Header();
+	void Append(int column, int64_t value);
+	void WriteBlock();
+	void AdvanceTail(uint32_t writeEnd);
+};
+
+} // namespace telemetry
+} // namespace phoenix
+} // namespace ctre
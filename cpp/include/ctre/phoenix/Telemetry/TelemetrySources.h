@@ -0,0 +1,86 @@
+#pragma once
+
+#include <stdint.h>
+#include "ctre/phoenix/MotorControl/IMotorController.h"
+#include "ctre/phoenix/Tasking/LoopableProfiler.h"
+#include "ctre/phoenix/Telemetry/TelemetryRecorder.h"
+#ifndef CTR_EXCLUDE_WPILIB_CLASSES
+#include "ctre/phoenix/Sensors/PigeonIMU.h"
+#endif
+
+namespace ctre {
+namespace phoenix {
+namespace telemetry {
+
+/**
+ * Records the status of a motor controller, as signals named
+ * "<prefix>.output", "<prefix>.position" and so on.
+ *
+ *	MotorControllerTelemetry leftTelem(recorder, "drive.left", &leftTalon);
+ */
+class MotorControllerTelemetry: public ITelemetrySource {
+public:
+	MotorControllerTelemetry(TelemetryRecorder & recorder, const char * prefix,
+			ctre::phoenix::motorcontrol::IMotorController * motorController,
+			int pidIdx = 0);
+	virtual void Sample();
+
+private:
+	ctre::phoenix::motorcontrol::IMotorController * _motorController;
+	int _pidIdx;
+	double _output = 0;
+	double _busVoltage = 0;
+	double _current = 0;
+	double _temperature = 0;
+	int32_t _position = 0;
+	int32_t _velocity = 0;
+	int32_t _closedLoopError = 0;
+	int32_t _faults = 0;
+	int32_t _lastError = 0;
+};
+
+#ifndef CTR_EXCLUDE_WPILIB_CLASSES
+/**
+ * Records the orientation and state of a Pigeon, as signals named
+ * "<prefix>.yaw", "<prefix>.state" and so on.
+ */
+class PigeonIMUTelemetry: public ITelemetrySource {
+public:
+	PigeonIMUTelemetry(TelemetryRecorder & recorder, const char * prefix,
+			ctre::phoenix::sensors::PigeonIMU * pigeon);
+	virtual void Sample();
+
+private:
+	ctre::phoenix::sensors::PigeonIMU * _pigeon;
+	double _ypr[3] = { 0, 0, 0 };
+	double _rawGyro[3] = { 0, 0, 0 };
+	double _fusedHeading = 0;
+	double _temperature = 0;
+	int32_t _state = 0;
+	int32_t _lastError = 0;
+};
+#endif // CTR_EXCLUDE_WPILIB_CLASSES
+
+/**
+ * Records the OnLoop timing of one scheduler slot from a LoopableProfiler,
+ * as signals named "<prefix>.meanUs", "<prefix>.maxUs" and so on.  The
+ * values are the profiler's running totals, differences between rows give
+ * per-tick figures.
+ */
+class LoopableProfilerTelemetry: public ITelemetrySource {
+public:
+	LoopableProfilerTelemetry(TelemetryRecorder & recorder,
+			const char * prefix,
+			const ctre::phoenix::tasking::LoopableProfiler * profiler,
+			int slot);
+	virtual void Sample();
+
+private:
+	const ctre::phoenix::tasking::LoopableProfiler * _profiler;
+	int _slot;
+	ctre::phoenix::tasking::LoopableProfiler::Stats _stats;
+};
+
+} // namespace telemetry
+} // namespace phoenix
+} // namespace ctre
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <stdint.h>
+#include <atomic>
+#include "ctre/phoenix/MonotonicClock.h"
+
+namespace ctre {
+namespace phoenix {
+
+/**
+ * Records named time spans ("zones") from any thread and writes them out as
+ * a Chrome trace (load in chrome://tracing or Perfetto) to see where loop
+ * time goes.
+ *
+ *	void Robot::TeleopPeriodic() {
+ *		ProfileZone zone("TeleopPeriodic");
+ *		{
+ *			ProfileZone drive("drive");
+ *			...
+ *		}
+ *	}
+ *	...
+ *	ZoneProfiler::WriteChromeTrace("/home/lvuser/trace.json");
+ *
+ * Each thread records into its own fixed size buffer with no locking, the
+ * buffer is only registered (under a lock) on the thread's first zone.  When
+ * a buffer fills, further zones on that thread are dropped and counted.  A
+ * thread's buffer is freed when the thread exits, so export before worker
+ * threads of interest end.
+ * While disabled, a zone costs one relaxed atomic load.
+ *
+ * Zone names must be string literals or otherwise outlive the export.
+ */
+class ZoneProfiler {
+public:
+	static const int kEventsPerThread = 8192;
+
+	static void SetEnabled(bool enable);
+	static bool IsEnabled() {
+		return _enabled.load(std::memory_order_relaxed);
+	}
+	static void Clear();
+	static uint32_t GetDroppedCount();
+	static bool WriteChromeTrace(const char * path);
+
+	/** called by ProfileZone */
+	static void Record(const char * name, int64_t startNs, int64_t endNs);
+
+private:
+	static std::atomic<bool> _enabled;
+};
+
+/**
+ * RAII zone, records the time from construction to destruction.
+ */
+class ProfileZone {
+public:
+	explicit ProfileZone(const char * name) :
+			_name(name), _startNs(ZoneProfiler::IsEnabled() ?
+					MonotonicClock::NowNs() : 0) {
+	}
+	~ProfileZone() {
+		if (_startNs != 0)
+			ZoneProfiler::Record(_name, _startNs, MonotonicClock::NowNs());
+	}
+	ProfileZone(ProfileZone const&) = delete;
+	ProfileZone& operator=(ProfileZone const&) = delete;
+private:
+	const char * _name;
+	int64_t _startNs; //!< 0 if profiler was disabled at construction
+};
+
+} // namespace phoenix
+} // namespace ctre
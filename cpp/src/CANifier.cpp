@@ -25,6 +25,7 @@
 #include "ctre/phoenix/CANifier.h"
 #include "ctre/phoenix/CCI/CANifier_CCI.h"
 #include "ctre/phoenix/CTRLogger.h"
+#include "ctre/phoenix/ErrorCounters.h"
 #include "HAL/HAL.h"
 
 namespace ctre {
@@ -36,6 +37,7 @@ namespace phoenix {
 CANifier::CANifier(int deviceNumber): CANBusAddressable(deviceNumber)
 {
 	m_handle = c_CANifier_Create1(deviceNumber);
+	ErrorCounters::Register(m_handle, ErrorCounters::CANifier, deviceNumber);
 	HAL_Report(HALUsageReporting::kResourceType_CANifier, deviceNumber + 1);
 }
 
@@ -55,7 +57,27 @@ ErrorCode CANifier::SetLEDOutput(double percentOutput, LEDChannel ledChannel) {
 	}
 	int dutyCycle = (int) (percentOutput * 1023); // [0,1023]
 
-	return c_CANifier_SetLEDOutput(m_handle, dutyCycle, ledChannel);
+	return ErrorCounters::Count(m_handle, c_CANifier_SetLEDOutput(m_handle, dutyCycle, ledChannel));
+}
+/**
+ * Sets all three LED outputs, e.g. the R, G and B of an LED strip.
+ * All three are carried by the same control frame, so they go out together
+ * on its next transmit.
+ * @param percentOutputA Output duty cycle of LEDChannelA.
+ * @param percentOutputB Output duty cycle of LEDChannelB.
+ * @param percentOutputC Output duty cycle of LEDChannelC.
+ * @return First Error Code generated by the three writes. 0 indicates no error.
+ */
+ErrorCode CANifier::SetLEDOutputs(double percentOutputA, double percentOutputB,
+		double percentOutputC) {
+	ErrorCode errA = SetLEDOutput(percentOutputA, LEDChannelA);
+	ErrorCode errB = SetLEDOutput(percentOutputB, LEDChannelB);
+	ErrorCode errC = SetLEDOutput(percentOutputC, LEDChannelC);
+	if (errA != OKAY)
+		return errA;
+	if (errB != OKAY)
+		return errB;
+	return errC;
 }
 
 /**
@@ -67,8 +89,9 @@ ErrorCode CANifier::SetLEDOutput(double percentOutput, LEDChannel ledChannel) {
  */
 ErrorCode CANifier::SetGeneralOutput(GeneralPin outputPin, bool outputValue,
 		bool outputEnable) {
-	return  c_CANifier_SetGeneralOutput(m_handle, outputPin, outputValue,
-			outputEnable);
+	return  ErrorCounters::Count(m_handle,
+			c_CANifier_SetGeneralOutput(m_handle, outputPin, outputValue,
+			outputEnable));
 }
 
 /**
@@ -78,7 +101,8 @@ ErrorCode CANifier::SetGeneralOutput(GeneralPin outputPin, bool outputValue,
  * @return Error Code generated by function. 0 indicates no error.
  */
 ErrorCode CANifier::SetGeneralOutputs(int outputBits, int isOutputBits) {
-	return c_CANifier_SetGeneralOutputs(m_handle, outputBits, isOutputBits);
+	return ErrorCounters::Count(m_handle,
+			c_CANifier_SetGeneralOutputs(m_handle, outputBits, isOutputBits));
 }
 
 /**
@@ -87,7 +111,8 @@ ErrorCode CANifier::SetGeneralOutputs(int outputBits, int isOutputBits) {
  * @return Error Code generated by function. 0 indicates no error.
  */
 ErrorCode CANifier::GetGeneralInputs(CANifier::PinValues &allPins) {
-	ErrorCode err = c_CANifier_GetGeneralInputs(m_handle, _tempPins, sizeof(_tempPins));
+	ErrorCode err = ErrorCounters::Count(m_handle,
+			c_CANifier_GetGeneralInputs(m_handle, _tempPins, sizeof(_tempPins)));
 	allPins.LIMF = _tempPins[LIMF];
 	allPins.LIMR = _tempPins[LIMR];
 	allPins.QUAD_A = _tempPins[QUAD_A];
@@ -109,7 +134,7 @@ ErrorCode CANifier::GetGeneralInputs(CANifier::PinValues &allPins) {
  */
 bool CANifier::GetGeneralInput(GeneralPin inputPin) {
 	bool retval = false;
-	(void)c_CANifier_GetGeneralInput(m_handle, inputPin, &retval);
+	(void)ErrorCounters::Count(m_handle, c_CANifier_GetGeneralInput(m_handle, inputPin, &retval));
 	return retval;
 }
 /**
@@ -119,7 +144,7 @@ bool CANifier::GetGeneralInput(GeneralPin inputPin) {
  */
 double CANifier::GetBusVoltage() {
 	double param = 0;
-	c_CANifier_GetBusVoltage(m_handle, &param);
+	ErrorCounters::Count(m_handle, c_CANifier_GetBusVoltage(m_handle, &param));
 	return param;
 }
 
@@ -155,8 +180,8 @@ ErrorCode CANifier::SetPWMOutput(int pwmChannel, double dutyCycle) {
 
 	int dutyCyc10bit = (int) (1023 * dutyCycle);
 
-	return c_CANifier_SetPWMOutput(m_handle, (int) pwmChannel,
-			dutyCyc10bit);
+	return ErrorCounters::Count(m_handle, c_CANifier_SetPWMOutput(m_handle, (int) pwmChannel,
+			dutyCyc10bit));
 }
 
 /**
@@ -171,8 +196,8 @@ ErrorCode CANifier::EnablePWMOutput(int pwmChannel, bool bEnable) {
 		pwmChannel = 0;
 	}
 
-	return c_CANifier_EnablePWMOutput(m_handle, (int) pwmChannel,
-			bEnable);
+	return ErrorCounters::Count(m_handle, c_CANifier_EnablePWMOutput(m_handle, (int) pwmChannel,
+			bEnable));
 }
 
 /**
@@ -182,8 +207,8 @@ ErrorCode CANifier::EnablePWMOutput(int pwmChannel, bool bEnable) {
  * @return Error Code generated by function. 0 indicates no error.
  */
 ErrorCode CANifier::GetPWMInput(PWMChannel pwmChannel, double dutyCycleAndPeriod[]) {
-	return c_CANifier_GetPWMInput(m_handle, pwmChannel,
-			dutyCycleAndPeriod);
+	return ErrorCounters::Count(m_handle, c_CANifier_GetPWMInput(m_handle, pwmChannel,
+			dutyCycleAndPeriod));
 }
 
 //------ Custom Persistent Params ----------//
@@ -207,7 +232,8 @@ ErrorCode CANifier::GetPWMInput(PWMChannel pwmChannel, double dutyCycleAndPeriod
  */
 ErrorCode CANifier::ConfigSetCustomParam(int newValue,
 		int paramIndex, int timeoutMs) {
-	return c_CANifier_ConfigSetCustomParam(m_handle, newValue, paramIndex, timeoutMs);
+	return ErrorCounters::Count(m_handle,
+			c_CANifier_ConfigSetCustomParam(m_handle, newValue, paramIndex, timeoutMs));
 }
 /**
  * Gets the value of a custom parameter. This is for arbitrary use.
@@ -227,7 +253,8 @@ ErrorCode CANifier::ConfigSetCustomParam(int newValue,
 int CANifier::ConfigGetCustomParam(
 		int paramIndex, int timeoutMs) {
 	int readValue;
-	c_CANifier_ConfigGetCustomParam(m_handle, &readValue, paramIndex, timeoutMs);
+	ErrorCounters::Count(m_handle,
+			c_CANifier_ConfigGetCustomParam(m_handle, &readValue, paramIndex, timeoutMs));
 	return readValue;
 }
 
@@ -255,7 +282,8 @@ int CANifier::ConfigGetCustomParam(
  */
 ErrorCode CANifier::ConfigSetParameter(ParamEnum param, double value,
 		uint8_t subValue, int ordinal, int timeoutMs) {
-	return c_CANifier_ConfigSetParameter(m_handle, param, value, subValue, ordinal, timeoutMs);
+	return ErrorCounters::Count(m_handle,
+			c_CANifier_ConfigSetParameter(m_handle, param, value, subValue, ordinal, timeoutMs));
 
 }
 /**
@@ -277,7 +305,8 @@ ErrorCode CANifier::ConfigSetParameter(ParamEnum param, double value,
  */
 double CANifier::ConfigGetParameter(ParamEnum param, int ordinal, int timeoutMs) {
 	double value = 0;
-	c_CANifier_ConfigGetParameter(m_handle, param, &value, ordinal, timeoutMs);
+	ErrorCounters::Count(m_handle,
+			c_CANifier_ConfigGetParameter(m_handle, param, &value, ordinal, timeoutMs));
 	return value;
 }
 
@@ -297,8 +326,9 @@ double CANifier::ConfigGetParameter(ParamEnum param, int ordinal, int timeoutMs)
  */
 ErrorCode CANifier::SetStatusFramePeriod(CANifierStatusFrame statusFrame, int periodMs,
 		int timeoutMs) {
-	return c_CANifier_SetStatusFramePeriod(m_handle, statusFrame, periodMs,
-			timeoutMs);
+	return ErrorCounters::Count(m_handle,
+			c_CANifier_SetStatusFramePeriod(m_handle, statusFrame, periodMs,
+			timeoutMs));
 }
 /**
  * Gets the period of the given status frame.
@@ -314,7 +344,8 @@ ErrorCode CANifier::SetStatusFramePeriod(CANifierStatusFrame statusFrame, int pe
 int CANifier::GetStatusFramePeriod(CANifierStatusFrame frame,
 		int timeoutMs) {
 	int periodMs = 0;
-	c_CANifier_GetStatusFramePeriod(m_handle, frame, &periodMs, timeoutMs);
+	ErrorCounters::Count(m_handle,
+			c_CANifier_GetStatusFramePeriod(m_handle, frame, &periodMs, timeoutMs));
 	return periodMs;
 }
 /**
@@ -328,7 +359,8 @@ int CANifier::GetStatusFramePeriod(CANifierStatusFrame frame,
  */
 ErrorCode CANifier::SetControlFramePeriod(CANifierControlFrame frame,
 		int periodMs) {
-	return c_CANifier_SetControlFramePeriod(m_handle, frame, periodMs);
+	return ErrorCounters::Count(m_handle,
+			c_CANifier_SetControlFramePeriod(m_handle, frame, periodMs));
 }
 //------ Firmware ----------//
 /**
@@ -338,7 +370,7 @@ ErrorCode CANifier::SetControlFramePeriod(CANifierControlFrame frame,
  */
 int CANifier::GetFirmwareVersion() {
 	int retval = -1;
-	c_CANifier_GetFirmwareVersion(m_handle, &retval);
+	ErrorCounters::Count(m_handle, c_CANifier_GetFirmwareVersion(m_handle, &retval));
 	return retval;
 }
 /**
@@ -348,7 +380,7 @@ int CANifier::GetFirmwareVersion() {
  */
 bool CANifier::HasResetOccurred() {
 	bool retval = false;
-	c_CANifier_HasResetOccurred(m_handle, &retval);
+	ErrorCounters::Count(m_handle, c_CANifier_HasResetOccurred(m_handle, &retval));
 	return retval;
 }
 //------ Faults ----------//
@@ -361,7 +393,7 @@ bool CANifier::HasResetOccurred() {
  */
 ErrorCode CANifier::GetFaults(CANifierFaults & toFill) {
 	int faultBits;
-	ErrorCode retval = c_CANifier_GetFaults(m_handle, &faultBits);
+	ErrorCode retval = ErrorCounters::Count(m_handle, c_CANifier_GetFaults(m_handle, &faultBits));
 	toFill = CANifierFaults(faultBits);
 	return retval;
 }
@@ -374,7 +406,7 @@ ErrorCode CANifier::GetFaults(CANifierFaults & toFill) {
  */
 ErrorCode CANifier::GetStickyFaults(CANifierStickyFaults & toFill) {
 	int faultBits;
-	ErrorCode retval = c_CANifier_GetFaults(m_handle, &faultBits);
+	ErrorCode retval = ErrorCounters::Count(m_handle, c_CANifier_GetFaults(m_handle, &faultBits));
 	toFill = CANifierStickyFaults(faultBits);
 	return retval;
 }
@@ -384,7 +416,7 @@ ErrorCode CANifier::GetStickyFaults(CANifierStickyFaults & toFill) {
  * @return Error Code generated by function. 0 indicates no error.
  */
 ErrorCode CANifier::ClearStickyFaults(int timeoutMs) {
-	return c_CANifier_ClearStickyFaults(m_handle, timeoutMs);
+	return ErrorCounters::Count(m_handle, c_CANifier_ClearStickyFaults(m_handle, timeoutMs));
 }
 
 } // phoenix
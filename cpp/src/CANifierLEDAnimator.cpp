@@ -0,0 +1,301 @@
+#ifndef CTR_EXCLUDE_WPILIB_CLASSES
+
+#include "ctre/phoenix/CANifierLEDAnimator.h"
+#include "ctre/phoenix/HsvToRgb.h"
+#include "ctre/phoenix/MonotonicClock.h"
+
+namespace ctre {
+namespace phoenix {
+
+/** fully saturated, full brightness color of each whole degree of hue */
+struct HueTable {
+	float rgb[361][3]; //!< entry 360 repeats 0 so lookups can blend up to it
+	HueTable() {
+		for (int h = 0; h < 360; ++h)
+			HsvToRgb::Convert(h, 1, 1, &rgb[h][0], &rgb[h][1], &rgb[h][2]);
+		for (int c = 0; c < 3; ++c)
+			rgb[360][c] = rgb[0][c];
+	}
+};
+static const HueTable & GetHueTable() {
+	static HueTable table;
+	return table;
+}
+
+/**
+ * Constructor
+ * @param canifier CANifier driving the LED strip.
+ * @param updatePeriodMs minimum time between updates, typically the
+ *                       period of the CANifier general control frame.
+ */
+CANifierLEDAnimator::CANifierLEDAnimator(CANifier * canifier,
+		int updatePeriodMs) {
+	_canifier = canifier;
+	SetChannels(CANifier::LEDChannelA, CANifier::LEDChannelB,
+			CANifier::LEDChannelC);
+	SetUpdatePeriod(updatePeriodMs);
+	_base.r = _base.g = _base.b = 0;
+	_color = _base;
+	for (int i = 0; i < 3; ++i)
+		_sent[i] = -1;
+	GetHueTable(); /* build table now rather than in the first loop */
+}
+/**
+ * Select which LED channel drives each color, default is A=red, B=green,
+ * C=blue.
+ */
+void CANifierLEDAnimator::SetChannels(CANifier::LEDChannel red,
+		CANifier::LEDChannel green, CANifier::LEDChannel blue) {
+	_channel[0] = (int) red;
+	_channel[1] = (int) green;
+	_channel[2] = (int) blue;
+	for (int i = 0; i < 3; ++i)
+		_sent[i] = -1;
+}
+void CANifierLEDAnimator::SetUpdatePeriod(int periodMs) {
+	_periodMs = (periodMs > 0) ? (uint32_t) periodMs : 1;
+}
+void CANifierLEDAnimator::SetOff() {
+	_effect = Off;
+	_restart = true;
+}
+/**
+ * @param hDegrees hue in degrees.
+ * @param S saturation [0,1].
+ * @param V value (brightness) [0,1].
+ */
+void CANifierLEDAnimator::SetSolid(double hDegrees, double S, double V) {
+	_effect = Solid;
+	_base = FromHsv(hDegrees, S, V);
+	_restart = true;
+}
+/**
+ * Brightness ramps from minV up to maxV and back each period.
+ * @param hDegrees hue in degrees.
+ * @param S saturation [0,1].
+ * @param periodMs duration of one full pulse.
+ * @param minV dimmest value [0,1].
+ * @param maxV brightest value [0,1].
+ */
+void CANifierLEDAnimator::SetPulse(double hDegrees, double S, int periodMs,
+		double minV, double maxV) {
+	_effect = Pulse;
+	_base = FromHsv(hDegrees, S, 1);
+	_effectPeriodMs = (periodMs > 1) ? (uint32_t) periodMs : 2;
+	_minV = (float) minV;
+	_maxV = (float) maxV;
+	_restart = true;
+}
+/**
+ * Hue sweeps once around the color wheel each period.
+ * @param periodMs duration of one sweep.
+ * @param S saturation [0,1].
+ * @param V value (brightness) [0,1].
+ */
+void CANifierLEDAnimator::SetRainbow(int periodMs, double S, double V) {
+	_effect = Rainbow;
+	_effectPeriodMs = (periodMs > 0) ? (uint32_t) periodMs : 1;
+	_saturation = (float) S;
+	_maxV = (float) V;
+	_restart = true;
+}
+void CANifierLEDAnimator::ClearKeyframes() {
+	_keyCount = 0;
+	_keysTotalMs = 0;
+}
+/**
+ * Append a keyframe, see PlayKeyframes().
+ * @param hDegrees hue in degrees.
+ * @param S saturation [0,1].
+ * @param V value (brightness) [0,1].
+ * @param durationMs how long this keyframe lasts.
+ * @param fadeIn true to blend from the previous keyframe's color over the
+ *               duration, false to show this color for the whole duration.
+ * @return false if there is no room for another keyframe.
+ */
+bool CANifierLEDAnimator::AddKeyframe(double hDegrees, double S, double V,
+		int durationMs, bool fadeIn) {
+	if (_keyCount >= kMaxKeyframes)
+		return false;
+	Keyframe & key = _keys[_keyCount++];
+	key.color = FromHsv(hDegrees, S, V);
+	key.durationMs = (durationMs > 0) ? (uint32_t) durationMs : 1;
+	key.fadeIn = fadeIn;
+	_keysTotalMs += key.durationMs;
+	return true;
+}
+/**
+ * Start playing the keyframes from the beginning.
+ * @param loop true to repeat forever, false to hold the last color and
+ *             report IsDone() once finished.
+ */
+void CANifierLEDAnimator::PlayKeyframes(bool loop) {
+	_effect = Keyframes;
+	_loop = loop;
+	_done = false;
+	_restart = true;
+}
+CANifierLEDAnimator::Effect CANifierLEDAnimator::GetEffect() const {
+	return _effect;
+}
+/**
+ * @return last computed color, each [0,1].
+ */
+void CANifierLEDAnimator::GetColor(float & r, float & g, float & b) const {
+	r = _color.r;
+	g = _color.g;
+	b = _color.b;
+}
+CANifierLEDAnimator::Rgb CANifierLEDAnimator::FromHsv(double hDegrees,
+		double S, double V) {
+	const HueTable & table = GetHueTable();
+	/* wrap hue into [0,360) */
+	double h = hDegrees - 360.0 * (int) (hDegrees / 360.0);
+	if (h < 0)
+		h += 360;
+	int i = (int) h;
+	if (i > 359)
+		i = 359;
+	float f = (float) (h - i);
+
+	/* blend neighbouring degrees, then apply saturation and value */
+	float s = (float) S;
+	float v = (float) V;
+	Rgb retval;
+	float * out[3] = { &retval.r, &retval.g, &retval.b };
+	for (int c = 0; c < 3; ++c) {
+		float hue = table.rgb[i][c] + f * (table.rgb[i + 1][c] - table.rgb[i][c]);
+		*out[c] = v * (1 - s * (1 - hue));
+	}
+	return retval;
+}
+CANifierLEDAnimator::Rgb CANifierLEDAnimator::Blend(const Rgb & a,
+		const Rgb & b, float t) {
+	Rgb retval;
+	retval.r = a.r + t * (b.r - a.r);
+	retval.g = a.g + t * (b.g - a.g);
+	retval.b = a.b + t * (b.b - a.b);
+	return retval;
+}
+CANifierLEDAnimator::Rgb CANifierLEDAnimator::Evaluate(uint32_t elapsedMs) {
+	Rgb retval;
+	retval.r = retval.g = retval.b = 0;
+
+	switch (_effect) {
+	case Off:
+		break;
+	case Solid:
+		retval = _base;
+		break;
+	case Pulse: {
+		/* triangle wave, 0 at start of period, 1 at half */
+		uint32_t half = _effectPeriodMs / 2;
+		uint32_t phase = elapsedMs % _effectPeriodMs;
+		float t = (phase < half) ?
+				(float) phase / half : (float) (_effectPeriodMs - phase) / half;
+		float v = _minV + t * (_maxV - _minV);
+		retval.r = _base.r * v;
+		retval.g = _base.g * v;
+		retval.b = _base.b * v;
+		break;
+	}
+	case Rainbow: {
+		double hue = 360.0 * (elapsedMs % _effectPeriodMs) / _effectPeriodMs;
+		retval = FromHsv(hue, _saturation, _maxV);
+		break;
+	}
+	case Keyframes: {
+		if (_keyCount == 0)
+			break;
+		if (_loop) {
+			elapsedMs %= _keysTotalMs;
+		} else if (elapsedMs >= _keysTotalMs) {
+			_done = true;
+			retval = _keys[_keyCount - 1].color;
+			break;
+		}
+		int k = 0;
+		while (elapsedMs >= _keys[k].durationMs) {
+			elapsedMs -= _keys[k].durationMs;
+			++k;
+		}
+		const Keyframe & key = _keys[k];
+		if (!key.fadeIn || (k == 0 && !_loop)) {
+			retval = key.color;
+		} else {
+			const Rgb & from = _keys[(k > 0) ? k - 1 : _keyCount - 1].color;
+			retval = Blend(from, key.color, (float) elapsedMs / key.durationMs);
+		}
+		break;
+	}
+	}
+	return retval;
+}
+void CANifierLEDAnimator::Write() {
+	float rgb[3] = { _color.r, _color.g, _color.b };
+	double out[3] = { 0, 0, 0 };
+	int duty[3];
+	bool changed = false;
+	for (int c = 0; c < 3; ++c) {
+		duty[c] = _sent[c];
+		int ch = _channel[c];
+		if (ch < 0 || ch > 2)
+			continue;
+		float v = rgb[c];
+		v = (v < 0) ? 0 : (v > 1) ? 1 : v;
+		out[ch] = v;
+		/* compare at the resolution the CANifier uses */
+		duty[c] = (int) (v * 1023);
+		if (duty[c] != _sent[c])
+			changed = true;
+	}
+	if (!changed)
+		return;
+	/* only remember what was actually sent, so a failed write is retried */
+	if (_canifier->SetLEDOutputs(out[0], out[1], out[2]) == OKAY) {
+		for (int c = 0; c < 3; ++c)
+			_sent[c] = duty[c];
+	}
+}
+/**
+ * Advance the animation, writing the LEDs if an update is due.
+ * Process() calls this with the steady clock, call it directly to drive the
+ * animation from another time base.
+ * @param nowMs current time in ms.
+ */
+void CANifierLEDAnimator::Update(uint32_t nowMs) {
+	if (_restart) {
+		/* new effect, show it now and restart its time base */
+		_restart = false;
+		_startMs = nowMs;
+	} else if (_hasUpdated && (nowMs - _lastUpdateMs) < _periodMs) {
+		return;
+	}
+	_hasUpdated = true;
+	_lastUpdateMs = nowMs;
+	_color = Evaluate(nowMs - _startMs);
+	Write();
+}
+void CANifierLEDAnimator::Process() {
+	Update((uint32_t) MonotonicClock::NowMs());
+}
+/* ILoopable */
+void CANifierLEDAnimator::OnStart() {
+	_restart = true;
+	_done = false;
+}
+void CANifierLEDAnimator::OnLoop() {
+	Process();
+}
+bool CANifierLEDAnimator::IsDone() {
+	return _effect == Keyframes && !_loop && _done;
+}
+void CANifierLEDAnimator::OnStop() {
+	SetOff();
+	Process();
+}
+
+} // namespace phoenix
+} // namespace ctre
+
+#endif // CTR_EXCLUDE_WPILIB_CLASSES
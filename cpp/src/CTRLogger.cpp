@@ -1,28 +1,363 @@
 #include "ctre/phoenix/CTRLogger.h"
 #include "ctre/phoenix/CCI/Logger_CCI.h" // c_Logger_*
+#include "ctre/phoenix/MonotonicClock.h"
+#include "ctre/phoenix/Tasking/MpscQueue.h"
 #include <execinfo.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 
 namespace ctre {
 namespace phoenix {
 
+namespace {
+
+const int kMaxEntries = 256; //!< distinct errors tracked, power of two
+const int kStackDepth = 12;
+const int kOriginLen = 64;
+/** frames of AsyncLog::Log and CTRLogger::Log at the top of each stack */
+const int kSkipFrames = 2;
+
+/**
+ * One distinct error.  The thread that claims the key fills in the rest and
+ * then publishes it with ready, other threads only touch count.
+ */
+struct Entry {
+	std::atomic<uint64_t> key; //!< 0 if unused
+	std::atomic<bool> ready;
+	std::atomic<uint32_t> count;
+	ErrorCode code;
+	char origin[kOriginLen];
+	void * stack[kStackDepth];
+	int depth;
+	void * callSite; //!< return address into the caller of CTRLogger::Log
+	/* background thread only */
+	bool reported;
+	uint32_t reportedCount;
+};
+
+class AsyncLog {
+public:
+	AsyncLog() :
+			_queue(64) {
+		Clear();
+	}
+	ErrorCode Log(ErrorCode code, const char * origin, void * callSite)
+			__attribute__((noinline));
+	void Start(bool open);
+	void Stop(bool close);
+	void SetRateLimit(int messagesPerSecond) {
+		_ratePerSec.store(messagesPerSecond > 0 ? messagesPerSecond : 1);
+	}
+	void SetRepeatReportPeriod(int periodMs) {
+		_repeatPeriodMs.store(periodMs > 0 ? periodMs : 1);
+	}
+	uint32_t GetDroppedCount() {
+		return _dropped.load(std::memory_order_relaxed);
+	}
+
+private:
+	Entry _entries[kMaxEntries];
+	tasking::MpscQueue<int> _queue; //!< indices of new entries
+	std::atomic<uint32_t> _dropped;
+	std::atomic<int> _ratePerSec;
+	std::atomic<int> _repeatPeriodMs;
+
+	std::atomic<bool> _running;
+	std::atomic<bool> _closed; //!< set by Close(), cleared by Open()
+	std::mutex _lock; //!< guards start/stop and the wakeup
+	std::mutex _stopLock; //!< serializes Stop(), held across the join
+	std::condition_variable _wake;
+	bool _stopping = false;
+	std::thread _thread;
+
+	/* background thread only */
+	double _tokens;
+	int64_t _lastRefillMs;
+	int64_t _lastRepeatMs;
+	int _repeatNext = 0; //!< where the rate limit cut off the last summary
+
+	void Clear();
+	void Run();
+	void Service(bool flush);
+	bool TakeToken(bool flush);
+	void ReportNew(Entry & entry);
+	void ReportRepeats(Entry & entry);
+};
+
+/** FNV-1a */
+uint64_t Hash(uint64_t h, const void * data, size_t len) {
+	const unsigned char * p = (const unsigned char *) data;
+	for (size_t i = 0; i < len; ++i) {
+		h ^= p[i];
+		h *= 1099511628211ull;
+	}
+	return h;
+}
+
+ErrorCode AsyncLog::Log(ErrorCode code, const char * origin, void * callSite) {
+	if (!_running.load(std::memory_order_acquire)) {
+		/* after Close() the CCI logger is gone, don't bring the thread back */
+		if (_closed.load(std::memory_order_acquire)) {
+			_dropped.fetch_add(1, std::memory_order_relaxed);
+			return code;
+		}
+		Start(false);
+	}
+
+	uint64_t key = 14695981039346656037ull;
+	key = Hash(key, &code, sizeof(code));
+	key = Hash(key, &callSite, sizeof(callSite));
+	key = Hash(key, origin, strlen(origin));
+	if (key == 0)
+		key = 1;
+
+	int idx = (int) key & (kMaxEntries - 1);
+	for (int probe = 0; probe < kMaxEntries; ++probe) {
+		Entry & entry = _entries[idx];
+		uint64_t existing = entry.key.load(std::memory_order_acquire);
+		if (existing == key) {
+			/* seen before, just count it */
+			entry.count.fetch_add(1, std::memory_order_relaxed);
+			return code;
+		}
+		if (existing == 0
+				&& entry.key.compare_exchange_strong(existing, key,
+						std::memory_order_acq_rel)) {
+			/* first occurrence, capture raw addresses only */
+			entry.code = code;
+			strncpy(entry.origin, origin, kOriginLen - 1);
+			entry.origin[kOriginLen - 1] = 0;
+			entry.depth = backtrace(entry.stack, kStackDepth);
+			entry.callSite = callSite;
+			entry.count.fetch_add(1, std::memory_order_relaxed);
+			entry.ready.store(true, std::memory_order_release);
+			if (_queue.TryPush(idx)) {
+				/* the background thread also scans for unreported entries,
+				 * so a full queue only delays the report */
+				_wake.notify_one();
+			}
+			return code;
+		}
+		if (existing == key)
+			continue; /* lost the race to the same key, recheck this slot */
+		idx = (idx + 1) & (kMaxEntries - 1);
+	}
+	/* table is full of other errors */
+	_dropped.fetch_add(1, std::memory_order_relaxed);
+	return code;
+}
+void AsyncLog::Clear() {
+	for (int i = 0; i < kMaxEntries; ++i) {
+		Entry & entry = _entries[i];
+		entry.key.store(0, std::memory_order_relaxed);
+		entry.ready.store(false, std::memory_order_relaxed);
+		entry.count.store(0, std::memory_order_relaxed);
+		entry.depth = 0;
+		entry.callSite = nullptr;
+		entry.reported = false;
+		entry.reportedCount = 0;
+	}
+	_dropped.store(0, std::memory_order_relaxed);
+	_ratePerSec.store(10);
+	_repeatPeriodMs.store(1000);
+	_running.store(false);
+	_closed.store(false);
+}
+/**
+ * Start the background thread if it isn't running.
+ * @param open true to also undo a Close(), false to do nothing once closed.
+ */
+void AsyncLog::Start(bool open) {
+	std::lock_guard<std::mutex> lck(_lock);
+	if (open)
+		_closed.store(false, std::memory_order_release);
+	if (_running.load(std::memory_order_relaxed)
+			|| _closed.load(std::memory_order_relaxed))
+		return;
+	/* first backtrace() may load the unwinder, do it here rather than in
+	 * a robot loop */
+	void * warmup[1];
+	backtrace(warmup, 1);
+
+	_stopping = false;
+	_tokens = _ratePerSec.load();
+	_lastRefillMs = _lastRepeatMs = MonotonicClock::NowMs();
+	_thread = std::thread(&AsyncLog::Run, this);
+	_running.store(true, std::memory_order_release);
+}
+/**
+ * Stop the background thread after sending everything still pending.
+ * @param close true to also refuse to restart until the next Start().
+ */
+void AsyncLog::Stop(bool close) {
+	std::lock_guard<std::mutex> stopLck(_stopLock);
+	{
+		std::lock_guard<std::mutex> lck(_lock);
+		if (close)
+			_closed.store(true, std::memory_order_release);
+		if (!_running.load(std::memory_order_relaxed))
+			return;
+		_stopping = true;
+	}
+	_wake.notify_one();
+	_thread.join();
+	_running.store(false, std::memory_order_release);
+}
+void AsyncLog::Run() {
+	std::unique_lock<std::mutex> lck(_lock);
+	while (!_stopping) {
+		lck.unlock();
+		Service(false);
+		lck.lock();
+		_wake.wait_for(lck, std::chrono::milliseconds(100));
+	}
+	lck.unlock();
+	Service(true);
+}
+/** @return true if a message may be sent now */
+bool AsyncLog::TakeToken(bool flush) {
+	if (flush)
+		return true;
+	int64_t now = MonotonicClock::NowMs();
+	int rate = _ratePerSec.load();
+	_tokens += (now - _lastRefillMs) * rate / 1000.0;
+	if (_tokens > rate)
+		_tokens = rate;
+	_lastRefillMs = now;
+	if (_tokens < 1)
+		return false;
+	_tokens -= 1;
+	return true;
+}
+void AsyncLog::ReportNew(Entry & entry) {
+	std::string stackTrace;
+	char ** strings = backtrace_symbols(entry.stack, entry.depth);
+	if (strings != nullptr) {
+		/* skip the logger's own frames, starting at the caller */
+		int first = kSkipFrames;
+		for (int i = 0; i < entry.depth; ++i) {
+			if (entry.stack[i] == entry.callSite) {
+				first = i;
+				break;
+			}
+		}
+		for (int i = first; i < entry.depth; i++) {
+			stackTrace += strings[i];
+			stackTrace += "\n";
+		}
+		free(strings);
+	}
+	entry.reported = true;
+	entry.reportedCount = 1;
+	c_Logger_Log(entry.code, entry.origin, 3, stackTrace.c_str());
+}
+void AsyncLog::ReportRepeats(Entry & entry) {
+	uint32_t count = entry.count.load(std::memory_order_relaxed);
+	char msg[kOriginLen + 48];
+	snprintf(msg, sizeof(msg), "%s (repeated %u times)", entry.origin,
+			(unsigned) (count - entry.reportedCount));
+	entry.reportedCount = count;
+	c_Logger_Log(entry.code, msg, 3, "");
+}
+void AsyncLog::Service(bool flush) {
+	/* new errors first, in the order they happened */
+	int idx;
+	while (_queue.TryPop(idx)) {
+		Entry & entry = _entries[idx];
+		if (!entry.reported && TakeToken(flush))
+			ReportNew(entry);
+	}
+	/* then anything left over from a full queue or the rate limit */
+	for (int i = 0; i < kMaxEntries; ++i) {
+		Entry & entry = _entries[i];
+		if (entry.ready.load(std::memory_order_acquire) && !entry.reported
+				&& TakeToken(flush))
+			ReportNew(entry);
+	}
+	/* summarize repeats once per period */
+	int64_t now = MonotonicClock::NowMs();
+	if (!flush && now - _lastRepeatMs < _repeatPeriodMs.load())
+		return;
+	_lastRepeatMs = now;
+	for (int n = 0; n < kMaxEntries; ++n) {
+		int i = (_repeatNext + n) & (kMaxEntries - 1);
+		Entry & entry = _entries[i];
+		if (!entry.reported)
+			continue;
+		if (entry.count.load(std::memory_order_relaxed) == entry.reportedCount)
+			continue;
+		if (!TakeToken(flush)) {
+			/* resume here next period so every error gets its turn */
+			_repeatNext = i;
+			break;
+		}
+		ReportRepeats(entry);
+	}
+}
+
+/**
+ * Never destroyed, so no thread is joined during static destruction.  The
+ * thread is stopped by CTRLogger::Close().
+ */
+AsyncLog & GetAsyncLog() {
+	static AsyncLog * log = new AsyncLog();
+	return *log;
+}
+
+} // namespace
+
 void CTRLogger::Open(int language) {
 	c_Logger_Open(language, true);
+	GetAsyncLog().Start(true);
+}
+/**
+ * Report an error.  Does nothing if code is OKAY.
+ * @param code error to report.
+ * @param origin where the error came from, e.g. the device and routine.
+ * @return code.
+ */
+ErrorCode CTRLogger::Log(ErrorCode code, const char * origin) {
+	if (code == OKAY)
+		return code;
+	return GetAsyncLog().Log(code, origin, __builtin_return_address(0));
 }
 ErrorCode CTRLogger::Log(ErrorCode code, std::string origin) {
-	void *buf[100];
-	char **strings;
-	int size = backtrace(buf, 100);
-	strings = backtrace_symbols(buf, size);
-	std::string stackTrace;
-	for (int i = 1; i < size; i++) {
-		stackTrace += strings[i];
-		stackTrace += "\n";
-	}
-	return c_Logger_Log(code, origin.c_str(), 3, stackTrace.c_str());
+	if (code == OKAY)
+		return code;
+	return GetAsyncLog().Log(code, origin.c_str(), __builtin_return_address(0));
 }
+/**
+ * Send everything still pending, then stop the background thread.  Errors
+ * logged after this are dropped until Open() is called again.
+ */
 void CTRLogger::Close() {
+	GetAsyncLog().Stop(true);
 	c_Logger_Close();
 }
+/**
+ * @param messagesPerSecond most messages sent per second, default 10.
+ */
+void CTRLogger::SetRateLimit(int messagesPerSecond) {
+	GetAsyncLog().SetRateLimit(messagesPerSecond);
+}
+/**
+ * @param periodMs how often repeat counts are sent, default 1000ms.
+ */
+void CTRLogger::SetRepeatReportPeriod(int periodMs) {
+	GetAsyncLog().SetRepeatReportPeriod(periodMs);
+}
+/**
+ * @return errors not reported because too many distinct errors were seen,
+ *         or because they were logged after Close().
+ */
+uint32_t CTRLogger::GetDroppedCount() {
+	return GetAsyncLog().GetDroppedCount();
+}
 //void CTRLogger::Description(ErrorCode code, const char *&shrt, const char *&lng) {
 //	c_Logger_Description(code, shrt, lng);
 //}
@@ -0,0 +1,144 @@
+#include "ctre/phoenix/Drive/DriveKinematics.h"
+#include <cmath>
+
+using namespace ctre::phoenix::motorcontrol;
+
+namespace ctre {
+namespace phoenix {
+namespace drive {
+
+DriveKinematics::DriveKinematics() :
+		_deadband(0.04f), _peak(1), _mode(ControlMode::PercentOutput), _fullScale(
+				1), _left(0), _right(0) {
+}
+/**
+ * Add a motor controller to one side of the drivetrain.
+ * @param motorController controller to drive, followers need not be added.
+ * @param side side the motor drives.
+ * @param gain multiplier for this motor's demand, -1 for a reversed motor.
+ * @return index of the motor in the demand batch.
+ */
+int DriveKinematics::Add(IMotorController * motorController, Side side,
+		float gain) {
+	_motors.push_back(motorController);
+	_leftGain.push_back((side == Left) ? gain : 0);
+	_rightGain.push_back((side == Right) ? gain : 0);
+	_demand.push_back(0);
+	return (int) _motors.size() - 1;
+}
+/**
+ * @param deadband inputs with a magnitude at or below this are zeroed, the
+ *                 rest of the range is rescaled to start from zero.
+ */
+void DriveKinematics::SetDeadband(float deadband) {
+	_deadband = (deadband < 0) ? 0 : (deadband > 0.99f) ? 0.99f : deadband;
+}
+/**
+ * @param peak largest side output magnitude [0,1].
+ */
+void DriveKinematics::SetPeakOutput(float peak) {
+	_peak = (peak < 0) ? 0 : (peak > 1) ? 1 : peak;
+}
+/**
+ * Select how demands are sent, default is PercentOutput.
+ * @param mode control mode passed to Set().
+ * @param fullScale demand for full output, e.g. top speed in native
+ *                  velocity units when mode is Velocity.
+ */
+void DriveKinematics::SetControlMode(ControlMode mode, float fullScale) {
+	_mode = mode;
+	_fullScale = fullScale;
+}
+/**
+ * Zero the deadband and rescale the remaining range back to [0,1].
+ */
+float DriveKinematics::ApplyDeadband(float value, float deadband) {
+	float mag = std::fabs(value) - deadband;
+	mag = (mag > 0) ? mag / (1 - deadband) : 0;
+	return std::copysign(mag, value);
+}
+/**
+ * Scale both sides down by the same factor if either exceeds full output.
+ */
+void DriveKinematics::Desaturate(float & left, float & right) {
+	float maxMag = std::fmax(std::fabs(left), std::fabs(right));
+	float scale = 1 / std::fmax(maxMag, 1.0f);
+	left *= scale;
+	right *= scale;
+}
+/**
+ * Single stick drive.
+ * @param forward forward throttle [-1,1].
+ * @param turn turn rate [-1,1], positive turns right.
+ */
+void DriveKinematics::Arcade(float forward, float turn) {
+	forward = ApplyDeadband(forward, _deadband);
+	turn = ApplyDeadband(turn, _deadband);
+	Output(forward + turn, forward - turn);
+}
+/**
+ * Car-like drive, the turn input sets the path curvature so turning slows
+ * with the throttle, which is easier to control at speed.
+ * @param forward forward throttle [-1,1].
+ * @param curvature curvature [-1,1], positive turns right.
+ * @param quickTurn true to turn in place, curvature then sets the turn rate.
+ */
+void DriveKinematics::Curvature(float forward, float curvature,
+		bool quickTurn) {
+	forward = ApplyDeadband(forward, _deadband);
+	curvature = ApplyDeadband(curvature, _deadband);
+	float turn = quickTurn ? curvature : std::fabs(forward) * curvature;
+	Output(forward + turn, forward - turn);
+}
+/**
+ * One input per side.
+ * @param left left side output [-1,1].
+ * @param right right side output [-1,1].
+ */
+void DriveKinematics::Tank(float left, float right) {
+	Output(ApplyDeadband(left, _deadband), ApplyDeadband(right, _deadband));
+}
+/**
+ * Command zero on every motor.
+ */
+void DriveKinematics::Stop() {
+	Output(0, 0);
+}
+void DriveKinematics::Output(float left, float right) {
+	Desaturate(left, right);
+	_left = left * _peak;
+	_right = right * _peak;
+
+	/* fan out to the demand batch, no per motor branching */
+	float l = _left * _fullScale;
+	float r = _right * _fullScale;
+	int count = (int) _demand.size();
+	const float * lg = _leftGain.data();
+	const float * rg = _rightGain.data();
+	float * demand = _demand.data();
+	for (int i = 0; i < count; ++i)
+		demand[i] = lg[i] * l + rg[i] * r;
+
+	for (int i = 0; i < count; ++i)
+		_motors[i]->Set(_mode, demand[i]);
+}
+int DriveKinematics::GetCount() const {
+	return (int) _motors.size();
+}
+/**
+ * @return last demand sent to each motor, in the order added.
+ */
+const float * DriveKinematics::GetDemands() const {
+	return _demand.data();
+}
+/**
+ * @return last side outputs [-1,1] before the control mode scaling.
+ */
+void DriveKinematics::GetSides(float & left, float & right) const {
+	left = _left;
+	right = _right;
+}
+
+} // namespace drive
+} // namespace phoenix
+} // namespace ctre
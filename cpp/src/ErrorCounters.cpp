@@ -0,0 +1,192 @@
+#include "ctre/phoenix/ErrorCounters.h"
+#include "ctre/phoenix/MonotonicClock.h"
+#include <mutex>
+
+namespace ctre {
+namespace phoenix {
+
+namespace {
+/** one error code of one device, claimed on the code's first occurrence */
+struct CodeSlot {
+	std::atomic<int32_t> code; //!< 0 (OKAY) if unused
+	std::atomic<uint32_t> count;
+	std::atomic<int64_t> firstUs;
+	std::atomic<int64_t> lastUs;
+	std::atomic<uint32_t> baseCount; //!< count at last Reset(), only Reset() writes
+};
+struct Device {
+	std::atomic<void *> handle; //!< nullptr if unused
+	ErrorCounters::DeviceType type;
+	int deviceNumber;
+	std::atomic<uint32_t> total;
+	std::atomic<uint32_t> baseTotal; //!< total at last Reset(), only Reset() writes
+	CodeSlot codes[ErrorCounters::kMaxCodes];
+};
+
+/* static storage, zero initialized before any device is constructed */
+Device s_devices[ErrorCounters::kMaxDevices];
+std::mutex s_lock; //!< guards registration and reset, not counting
+
+/** only for a device no one is counting into, i.e. before it is published */
+void Clear(Device & dev) {
+	dev.total.store(0, std::memory_order_relaxed);
+	dev.baseTotal.store(0, std::memory_order_relaxed);
+	for (CodeSlot & slot : dev.codes) {
+		slot.code.store(0, std::memory_order_relaxed);
+		slot.count.store(0, std::memory_order_relaxed);
+		slot.firstUs.store(0, std::memory_order_relaxed);
+		slot.lastUs.store(0, std::memory_order_relaxed);
+		slot.baseCount.store(0, std::memory_order_relaxed);
+	}
+}
+void Fill(const Device & dev, ErrorCounters::Snapshot & snapshot) {
+	snapshot.type = dev.type;
+	snapshot.deviceNumber = dev.deviceNumber;
+	snapshot.totalCount = dev.total.load(std::memory_order_relaxed)
+			- dev.baseTotal.load(std::memory_order_relaxed);
+	snapshot.codeCount = 0;
+	for (const CodeSlot & slot : dev.codes) {
+		int32_t code = slot.code.load(std::memory_order_acquire);
+		if (code == 0)
+			break; /* slots are claimed in order */
+		uint32_t count = slot.count.load(std::memory_order_relaxed)
+				- slot.baseCount.load(std::memory_order_relaxed);
+		if (count == 0)
+			continue; /* not seen since Reset() */
+		ErrorCounters::CodeCount & out = snapshot.codes[snapshot.codeCount++];
+		out.code = (ErrorCode) code;
+		out.count = count;
+		out.firstUs = slot.firstUs.load(std::memory_order_relaxed);
+		out.lastUs = slot.lastUs.load(std::memory_order_relaxed);
+	}
+}
+} // namespace
+
+/**
+ * Start counting errors for a device, called by the device's constructor.
+ * @param handle device's low level handle.
+ * @param type kind of device.
+ * @param deviceNumber device's CAN ID.
+ */
+void ErrorCounters::Register(void * handle, DeviceType type,
+		int deviceNumber) {
+	std::lock_guard<std::mutex> lck(s_lock);
+	Device * freeDev = nullptr;
+	for (Device & dev : s_devices) {
+		void * existing = dev.handle.load(std::memory_order_relaxed);
+		if (existing == handle)
+			return; /* already registered, keep its counts */
+		if (existing == nullptr && freeDev == nullptr)
+			freeDev = &dev;
+	}
+	if (freeDev == nullptr)
+		return; /* table full, this device isn't counted */
+	freeDev->type = type;
+	freeDev->deviceNumber = deviceNumber;
+	Clear(*freeDev);
+	freeDev->handle.store(handle, std::memory_order_release);
+}
+/**
+ * Stop counting errors for a device, called by the device's destructor.
+ */
+void ErrorCounters::Unregister(void * handle) {
+	std::lock_guard<std::mutex> lck(s_lock);
+	for (Device & dev : s_devices) {
+		if (dev.handle.load(std::memory_order_relaxed) == handle)
+			dev.handle.store(nullptr, std::memory_order_release);
+	}
+}
+void ErrorCounters::CountError(void * handle, ErrorCode code) {
+	Device * found = nullptr;
+	for (Device & dev : s_devices) {
+		if (dev.handle.load(std::memory_order_acquire) == handle) {
+			found = &dev;
+			break;
+		}
+	}
+	if (found == nullptr)
+		return;
+
+	int64_t now = MonotonicClock::NowUs();
+	found->total.fetch_add(1, std::memory_order_relaxed);
+	for (CodeSlot & slot : found->codes) {
+		int32_t existing = slot.code.load(std::memory_order_acquire);
+		if (existing == 0) {
+			/* times are written before the release CAS publishes the code,
+			 * so a reader that sees the code sees them too.  A thread that
+			 * loses the race may overwrite them with its own 'now', which
+			 * is only microseconds apart */
+			slot.firstUs.store(now, std::memory_order_relaxed);
+			slot.lastUs.store(now, std::memory_order_relaxed);
+			if (slot.code.compare_exchange_strong(existing, (int32_t) code,
+					std::memory_order_acq_rel)) {
+				slot.count.fetch_add(1, std::memory_order_relaxed);
+				return;
+			}
+			/* else existing now holds whichever code claimed the slot */
+		}
+		if (existing == code) {
+			uint32_t count = slot.count.fetch_add(1, std::memory_order_relaxed);
+			/* first time since Reset() */
+			if (count == slot.baseCount.load(std::memory_order_relaxed))
+				slot.firstUs.store(now, std::memory_order_relaxed);
+			slot.lastUs.store(now, std::memory_order_relaxed);
+			return;
+		}
+	}
+	/* more distinct codes than slots, only counted in the total */
+}
+/**
+ * Copy the counters of every registered device.  Each counter is read
+ * atomically but the set is not a single consistent instant.
+ * @param snapshots array to fill.
+ * @param capacity size of snapshots.
+ * @return number of devices filled in.
+ */
+int ErrorCounters::GetSnapshot(Snapshot * snapshots, int capacity) {
+	int count = 0;
+	for (const Device & dev : s_devices) {
+		if (count >= capacity)
+			break;
+		if (dev.handle.load(std::memory_order_acquire) == nullptr)
+			continue;
+		Fill(dev, snapshots[count++]);
+	}
+	return count;
+}
+/**
+ * Copy the counters of one device.
+ * @return false if no such device is registered.
+ */
+bool ErrorCounters::GetSnapshot(DeviceType type, int deviceNumber,
+		Snapshot & snapshot) {
+	for (const Device & dev : s_devices) {
+		if (dev.handle.load(std::memory_order_acquire) == nullptr)
+			continue;
+		if (dev.type == type && dev.deviceNumber == deviceNumber) {
+			Fill(dev, snapshot);
+			return true;
+		}
+	}
+	return false;
+}
+/**
+ * Zero every device's counters, e.g. at the start of a match.  Current
+ * counts become the baseline snapshots are taken against, so this can run
+ * while other threads are counting: an error counted at the same time lands
+ * on one side of the reset or the other.
+ */
+void ErrorCounters::Reset() {
+	std::lock_guard<std::mutex> lck(s_lock);
+	for (Device & dev : s_devices) {
+		dev.baseTotal.store(dev.total.load(std::memory_order_relaxed),
+				std::memory_order_relaxed);
+		for (CodeSlot & slot : dev.codes) {
+			slot.baseCount.store(slot.count.load(std::memory_order_relaxed),
+					std::memory_order_relaxed);
+		}
+	}
+}
+
+} // namespace phoenix
+} // namespace ctre
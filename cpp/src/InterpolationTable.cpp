@@ -0,0 +1,101 @@
+#include "ctre/phoenix/InterpolationTable.h"
+#include <algorithm>
+#include <cmath>
+
+namespace ctre {
+namespace phoenix {
+
+/**
+ * Constructor
+ * @param x breakpoint inputs, strictly increasing.
+ * @param y output at each breakpoint.
+ * @param count number of breakpoints, at least 2.
+ * @param outOfRange what to do with inputs outside [x[0], x[count-1]].
+ */
+InterpolationTable::InterpolationTable(const double * x, const double * y,
+		int count, OutOfRange outOfRange) :
+		_x(x, x + count), _y(y, y + count), _outOfRange(outOfRange) {
+	Init();
+}
+/**
+ * Constructor for evenly spaced breakpoints.
+ * @param xMin input of first breakpoint.
+ * @param xMax input of last breakpoint.
+ * @param y output at each breakpoint.
+ * @param count number of breakpoints, at least 2.
+ * @param outOfRange what to do with inputs outside [xMin, xMax].
+ */
+InterpolationTable::InterpolationTable(double xMin, double xMax,
+		const double * y, int count, OutOfRange outOfRange) :
+		_y(y, y + count), _outOfRange(outOfRange) {
+	_x.resize(count);
+	for (int i = 0; i < count; ++i)
+		_x[i] = (count > 1) ? xMin + (xMax - xMin) * i / (count - 1) : xMin;
+	Init();
+}
+void InterpolationTable::Init() {
+	int segments = (int) _x.size() - 1;
+	_slope.resize(segments > 0 ? segments : 0);
+	for (int i = 0; i < segments; ++i)
+		_slope[i] = (_y[i + 1] - _y[i]) / (_x[i + 1] - _x[i]);
+
+	/* evenly spaced breakpoints allow computing the segment directly */
+	_uniform = false;
+	_invStep = 0;
+	if (segments > 0) {
+		double step = (_x[segments] - _x[0]) / segments;
+		_uniform = true;
+		for (int i = 0; i < segments; ++i) {
+			double dx = _x[i + 1] - _x[i];
+			if (std::fabs(dx - step) > step * 1e-9) {
+				_uniform = false;
+				break;
+			}
+		}
+		if (_uniform)
+			_invStep = 1.0 / step;
+	}
+}
+/** index of segment to use for x, end segments are used outside the table */
+int InterpolationTable::FindSegment(double x) const {
+	int last = (int) _slope.size() - 1;
+	int i;
+	if (_uniform) {
+		double pos = (x - _x[0]) * _invStep;
+		i = !(pos > 0) ? 0 : (pos >= last) ? last : (int) pos;
+	} else {
+		/* first breakpoint above x, segment starts one before it */
+		i = (int) (std::upper_bound(_x.begin() + 1, _x.end() - 1, x)
+				- _x.begin()) - 1;
+	}
+	return i;
+}
+/**
+ * @param x input.
+ * @return interpolated output.
+ */
+double InterpolationTable::Lookup(double x) const {
+	if (_slope.empty())
+		return _y.empty() ? 0 : _y[0];
+	if (_outOfRange == Clamp) {
+		if (x <= _x.front())
+			return _y.front();
+		if (x >= _x.back())
+			return _y.back();
+	}
+	int i = FindSegment(x);
+	return _y[i] + _slope[i] * (x - _x[i]);
+}
+/**
+ * Evaluate many inputs at once.
+ * @param x inputs.
+ * @param y outputs, may be the same array as x.
+ * @param count number of inputs.
+ */
+void InterpolationTable::Lookup(const double * x, double * y, int count) const {
+	for (int i = 0; i < count; ++i)
+		y[i] = Lookup(x[i]);
+}
+
+} // namespace phoenix
+} // namespace ctre
@@ -0,0 +1,148 @@
+#include "ctre/phoenix/Motion/CompactTrajectoryBuffer.h"
+
+namespace ctre {
+namespace phoenix {
+namespace motion {
+
+static_assert(sizeof(CompactTrajectoryPoint) == 12,
+		"CompactTrajectoryPoint is expected to pack into 12 bytes");
+
+/** heading scalar, matches the FLOAT_TO_FXP_0_8 scaling used by the low level */
+static const double FLOAT_TO_FXP_HEADING = (double) (1 << CompactTrajectoryPoint::kHeadingFractionalBits);
+static const double FXP_TO_FLOAT_HEADING = 1.0 / FLOAT_TO_FXP_HEADING;
+
+/**
+ * Round to nearest and saturate into [min,max].  NaN becomes 0, converting
+ * it to an integer would be undefined.
+ */
+static int32_t RoundAndCap(double value, double min, double max) {
+	if (value != value)
+		return 0;
+	if (value >= max)
+		return (int32_t) max;
+	if (value <= min)
+		return (int32_t) min;
+	if (value < 0)
+		return (int32_t) (value - 0.5);
+	return (int32_t) (value + 0.5);
+}
+
+//--------------------- CompactTrajectoryPoint -----------------------------//
+CompactTrajectoryPoint CompactTrajectoryPoint::FromTrajectoryPoint(
+		const TrajectoryPoint & pt) {
+	CompactTrajectoryPoint retval;
+	retval.position = RoundAndCap(pt.position, INT32_MIN, INT32_MAX);
+	retval.velocity = RoundAndCap(pt.velocity, INT32_MIN, INT32_MAX);
+	retval.headingFxp = RoundAndCap(pt.headingDeg * FLOAT_TO_FXP_HEADING,
+			-0x800000, 0x7FFFFF);
+	/* a larger slot would be silently truncated by the bit-field */
+	retval.profileSlotSelect =
+			(pt.profileSlotSelect > CompactTrajectoryPoint::kMaxProfileSlotSelect) ?
+					CompactTrajectoryPoint::kMaxProfileSlotSelect :
+					pt.profileSlotSelect;
+	retval.isLastPoint = pt.isLastPoint;
+	retval.zeroPos = pt.zeroPos;
+	return retval;
+}
+void CompactTrajectoryPoint::ToTrajectoryPoint(TrajectoryPoint & pt) const {
+	pt.position = position;
+	pt.velocity = velocity;
+	pt.headingDeg = GetHeadingDeg();
+	pt.profileSlotSelect = profileSlotSelect;
+	pt.isLastPoint = isLastPoint;
+	pt.zeroPos = zeroPos;
+}
+double CompactTrajectoryPoint::GetHeadingDeg() const {
+	return headingFxp * FXP_TO_FLOAT_HEADING;
+}
+
+//--------------------- CompactTrajectoryBuffer -----------------------------//
+/**
+ * Constructor
+ * @param capacity Maximum number of points held.  Storage is allocated here
+ *                 and never grows.
+ */
+CompactTrajectoryBuffer::CompactTrajectoryBuffer(int capacity) {
+	_cap = capacity;
+	_d = new CompactTrajectoryPoint[_cap];
+}
+CompactTrajectoryBuffer::~CompactTrajectoryBuffer() {
+	delete[] _d;
+	_d = 0;
+}
+/**
+ * Quantize and push a trajectory point.
+ * @return true if point was inserted, false if buffer is full.
+ */
+bool CompactTrajectoryBuffer::Write(const TrajectoryPoint & pt) {
+	return Write(CompactTrajectoryPoint::FromTrajectoryPoint(pt));
+}
+/**
+ * Push an already quantized point.
+ * @return true if point was inserted, false if buffer is full.
+ */
+bool CompactTrajectoryBuffer::Write(const CompactTrajectoryPoint & pt) {
+	if (_cnt >= _cap)
+		return false;
+	_d[_in] = pt;
+	if (++_in >= _cap)
+		_in = 0;
+	++_cnt;
+	return true;
+}
+/**
+ * @return the oldest point, or null if empty.
+ */
+const CompactTrajectoryPoint * CompactTrajectoryBuffer::Front() const {
+	if (_cnt == 0)
+		return nullptr;
+	return &_d[_ou];
+}
+/**
+ * Remove the oldest point.
+ * @return true if a point was removed.
+ */
+bool CompactTrajectoryBuffer::Pop() {
+	if (_cnt == 0)
+		return false;
+	if (++_ou >= _cap)
+		_ou = 0;
+	--_cnt;
+	return true;
+}
+/**
+ * Get the oldest points that are contiguous in memory.  When the ring has
+ * wrapped, the rest follow once these are popped.
+ * @param pts filled with the oldest point.
+ * @return number of points readable from pts, 0 if empty.
+ */
+int CompactTrajectoryBuffer::Peek(const CompactTrajectoryPoint * & pts) const {
+	pts = &_d[_ou];
+	int run = _cap - _ou;
+	return (_cnt < run) ? _cnt : run;
+}
+/**
+ * Remove the oldest points.
+ * @param count number of points to remove.
+ * @return number of points removed, less than count if buffer ran empty.
+ */
+int CompactTrajectoryBuffer::Pop(int count) {
+	if (count > _cnt)
+		count = _cnt;
+	if (count <= 0)
+		return 0;
+	_ou += count;
+	if (_ou >= _cap)
+		_ou -= _cap;
+	_cnt -= count;
+	return count;
+}
+void CompactTrajectoryBuffer::Clear() {
+	_in = 0;
+	_ou = 0;
+	_cnt = 0;
+}
+
+} // namespace motion
+} // namespace phoenix
+} // namespace ctre
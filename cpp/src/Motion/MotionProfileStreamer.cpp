@@ -0,0 +1,105 @@
+#include "ctre/phoenix/Motion/MotionProfileStreamer.h"
+#include "ctre/phoenix/MotorControl/CAN/BaseMotorController.h"
+
+namespace ctre {
+namespace phoenix {
+namespace motion {
+
+/**
+ * Constructor
+ * @param motorController controller to stream into.
+ * @param topBufferDepth max number of points to keep in the top level buffer.
+ *                       A shallow top buffer keeps the bulk of the profile in
+ *                       its compact, prepared form.
+ */
+MotionProfileStreamer::MotionProfileStreamer(
+		ctre::phoenix::motorcontrol::can::BaseMotorController * motorController,
+		int topBufferDepth) {
+	_motorController = motorController;
+	_topBufferDepth = topBufferDepth;
+}
+/**
+ * Begin streaming a profile from its first point.  Caller is responsible for
+ * clearing any previous trajectories and for putting the controller in
+ * MotionProfile mode.
+ * @param profile prepared profile, must outlive the streaming.  Splice()
+ *                modifies this profile.
+ */
+void MotionProfileStreamer::Start(PreparedMotionProfile * profile) {
+	_profile = profile;
+	_idx = 0;
+}
+/**
+ * Stop sending points.  Points already in the buffers are not cleared.
+ */
+void MotionProfileStreamer::Stop() {
+	_profile = nullptr;
+	_idx = 0;
+}
+/**
+ * Replace the not-yet-sent tail of the profile with a new segment while the
+ * executer keeps running.  Points already handed to the top level buffer
+ * cannot be replaced, so the splice is moved to the next unsent point if
+ * fromIndex is earlier.  Once every point has been sent the executer has
+ * already been given the final point, so nothing can be appended.
+ * @param fromIndex requested first index to replace.
+ * @param points new segment.
+ * @param count number of points in new segment, 0 truncates the profile at
+ *              fromIndex.
+ * @param blendPoints number of points to cross-fade over to keep velocity
+ *                    continuous at the splice.
+ * @return index where the new segment begins, or -1 if not streaming or the
+ *         splice would end the profile on a point that was already sent
+ *         (including once the final point has been sent).
+ */
+int MotionProfileStreamer::Splice(int fromIndex,
+		const TrajectoryPoint * points, int count, int blendPoints) {
+	if (_profile == nullptr)
+		return -1;
+	if (_idx >= _profile->GetCount())
+		return -1;
+	if (count < 0)
+		count = 0;
+	if (fromIndex < _idx)
+		fromIndex = _idx;
+	if (fromIndex > _profile->GetCount())
+		fromIndex = _profile->GetCount();
+	/* the new final point must be one the executer hasn't been given yet */
+	if (count == 0 && fromIndex <= _idx)
+		return -1;
+	_profile->Splice(fromIndex, points, count, blendPoints);
+	return fromIndex;
+}
+/**
+ * Same as Splice(), with the splice point given as time since the start of
+ * the profile.
+ * @param timeMs time into the profile to splice at.
+ * @param pointDurationMs duration of each trajectory point.
+ */
+int MotionProfileStreamer::SpliceAtTime(int timeMs, int pointDurationMs,
+		const TrajectoryPoint * points, int count, int blendPoints) {
+	if (pointDurationMs < 1)
+		pointDurationMs = 1;
+	return Splice(timeMs / pointDurationMs, points, count, blendPoints);
+}
+int MotionProfileStreamer::GetRemaining() const {
+	if (_profile == nullptr)
+		return 0;
+	return _profile->GetCount() - _idx;
+}
+bool MotionProfileStreamer::IsDone() const {
+	return GetRemaining() <= 0;
+}
+void MotionProfileStreamer::Process() {
+	if (_profile != nullptr && _idx < _profile->GetCount()) {
+		/* a full top buffer stops the push, the rest goes next time */
+		_idx += _motorController->PushMotionProfileTrajectories(
+				_profile->GetPoints() + _idx, _profile->GetCount() - _idx,
+				_topBufferDepth);
+	}
+	_motorController->ProcessMotionProfileBuffer();
+}
+
+} // namespace motion
+} // namespace phoenix
+} // namespace ctre
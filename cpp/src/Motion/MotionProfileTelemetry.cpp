@@ -0,0 +1,204 @@
+#include "ctre/phoenix/Motion/MotionProfileTelemetry.h"
+#include "ctre/phoenix/MotorControl/IMotorController.h"
+#include "ctre/phoenix/MonotonicClock.h"
+
+namespace ctre {
+namespace phoenix {
+namespace motion {
+
+/** weight of the newest rate measurement in the running estimates */
+static const double kRateFilterGain = 0.3;
+/** buffer counts are integral, so measure rates over a window of samples */
+static const double kRateWindowSec = 0.1;
+
+/**
+ * Constructor
+ * @param motorController controller to sample when Process() is used.
+ * @param trajectoryPointDurationMs duration of each trajectory point, used as
+ *                                  the nominal drain rate of the bottom buffer.
+ */
+MotionProfileTelemetry::MotionProfileTelemetry(
+		ctre::phoenix::motorcontrol::IMotorController * motorController,
+		int trajectoryPointDurationMs) {
+	_motorController = motorController;
+	if (trajectoryPointDurationMs < 1)
+		trajectoryPointDurationMs = 1;
+	_nominalDrainRate = 1000.0 / trajectoryPointDurationMs;
+	Reset();
+}
+/**
+ * Clear all estimates and statistics.
+ */
+void MotionProfileTelemetry::Reset() {
+	/* assume download keeps up until measured otherwise */
+	_fillRate = _nominalDrainRate;
+	_drainRate = _nominalDrainRate;
+	_timeToUnderrun = -1;
+	_underrunPredicted = false;
+	_hasWindow = false;
+	_warningCount = 0;
+	_underrunSampleCount = 0;
+	for (int i = 0; i < kHistogramBins; ++i)
+		_depthHistogram[i] = 0;
+}
+/**
+ * @param seconds raise a warning once the bottom buffer is predicted to run
+ *                empty within this many seconds.
+ */
+void MotionProfileTelemetry::SetWarningThreshold(double seconds) {
+	_warningThreshold = seconds;
+}
+/**
+ * Allow telemetry to shorten the Control_6 period when an underrun is predicted.
+ * The period is halved on each new warning, down to minPeriodMs, and set back
+ * to initialPeriodMs once the profile stops executing.
+ * @param enable true to allow period changes, false to restore the original
+ *               period (if it was shortened) and stop changing it.
+ * @param initialPeriodMs period currently in use by the controller.
+ * @param minPeriodMs shortest period telemetry may select.
+ */
+void MotionProfileTelemetry::EnableAutoFramePeriod(bool enable,
+		int initialPeriodMs, int minPeriodMs) {
+	if (!enable) {
+		RestoreFramePeriod();
+		_autoFramePeriod = false;
+		return;
+	}
+	_autoFramePeriod = true;
+	_control6PeriodMs = initialPeriodMs;
+	_originalControl6PeriodMs = initialPeriodMs;
+	_minControl6PeriodMs = minPeriodMs;
+}
+/**
+ * Feed one snapshot of the motion profile status.
+ * @param status snapshot from GetMotionProfileStatus().
+ * @param timestampSec monotonic time of the snapshot in seconds.
+ */
+void MotionProfileTelemetry::Sample(const MotionProfileStatus & status,
+		double timestampSec) {
+	/* depth histogram */
+	int bin = status.btmBufferCnt / kHistogramBinWidth;
+	if (bin < 0)
+		bin = 0;
+	if (bin >= kHistogramBins)
+		bin = kHistogramBins - 1;
+	++_depthHistogram[bin];
+
+	if (status.isUnderrun)
+		++_underrunSampleCount;
+
+	bool executing = (status.outputEnable == SetValueMotionProfile::Enable)
+			&& status.activePointValid && !status.isLast;
+
+	if (!executing) {
+		/* restart rate measurement once executer is running */
+		_hasWindow = false;
+		/* finished or disabled, the faster download is no longer needed */
+		if (_autoFramePeriod)
+			RestoreFramePeriod();
+	} else if (!_hasWindow) {
+		_hasWindow = true;
+		_windowTopEmpty = true;
+		_windowBtmCnt = status.btmBufferCnt;
+		_windowTimestamp = timestampSec;
+	} else {
+		_windowTopEmpty = _windowTopEmpty && (status.topBufferCnt == 0);
+
+		double dt = timestampSec - _windowTimestamp;
+		if (dt >= kRateWindowSec) {
+			double btmRate = (status.btmBufferCnt - _windowBtmCnt) / dt;
+
+			if (_windowTopEmpty && status.btmBufferCnt > 0) {
+				/* nothing to fill with, so the bottom buffer is only draining */
+				_drainRate += kRateFilterGain * (-btmRate - _drainRate);
+				_fillRate += kRateFilterGain * (0 - _fillRate);
+			} else {
+				_fillRate += kRateFilterGain
+						* (btmRate + _drainRate - _fillRate);
+			}
+			_windowTopEmpty = (status.topBufferCnt == 0);
+			_windowBtmCnt = status.btmBufferCnt;
+			_windowTimestamp = timestampSec;
+		}
+	}
+
+	/* predict when the bottom buffer runs dry */
+	double netDrain = _drainRate - _fillRate;
+	if (executing && netDrain > 0) {
+		_timeToUnderrun = status.btmBufferCnt / netDrain;
+	} else {
+		_timeToUnderrun = -1;
+	}
+
+	bool predicted = (_timeToUnderrun >= 0)
+			&& (_timeToUnderrun < _warningThreshold);
+	if (predicted && !_underrunPredicted) {
+		/* new warning */
+		++_warningCount;
+		if (_autoFramePeriod)
+			ShortenFramePeriod();
+	}
+	_underrunPredicted = predicted;
+
+}
+void MotionProfileTelemetry::ShortenFramePeriod() {
+	int periodMs = _control6PeriodMs / 2;
+	if (periodMs < _minControl6PeriodMs)
+		periodMs = _minControl6PeriodMs;
+	if (periodMs != _control6PeriodMs) {
+		if (_motorController->ChangeMotionControlFramePeriod(periodMs)
+				== OKAY) {
+			_control6PeriodMs = periodMs;
+		}
+	}
+}
+/** put back the period that was in use before ShortenFramePeriod() */
+void MotionProfileTelemetry::RestoreFramePeriod() {
+	if (_control6PeriodMs == _originalControl6PeriodMs)
+		return;
+	if (_motorController->ChangeMotionControlFramePeriod(
+			_originalControl6PeriodMs) == OKAY) {
+		_control6PeriodMs = _originalControl6PeriodMs;
+	}
+}
+double MotionProfileTelemetry::GetFillRate() const {
+	return _fillRate;
+}
+double MotionProfileTelemetry::GetDrainRate() const {
+	return _drainRate;
+}
+double MotionProfileTelemetry::GetTimeToUnderrun() const {
+	return _timeToUnderrun;
+}
+bool MotionProfileTelemetry::IsUnderrunPredicted() const {
+	return _underrunPredicted;
+}
+int MotionProfileTelemetry::GetWarningCount() const {
+	return _warningCount;
+}
+int MotionProfileTelemetry::GetUnderrunSampleCount() const {
+	return _underrunSampleCount;
+}
+int MotionProfileTelemetry::GetControlFramePeriodMs() const {
+	return _control6PeriodMs;
+}
+/**
+ * @return kHistogramBins counters of bottom buffer depth,
+ *         bin i counts samples with depth in [i*kHistogramBinWidth, (i+1)*kHistogramBinWidth).
+ */
+const uint32_t * MotionProfileTelemetry::GetDepthHistogram() const {
+	return _depthHistogram;
+}
+/**
+ * Sample the controller's status now.  Call once per loop.
+ */
+void MotionProfileTelemetry::Process() {
+	MotionProfileStatus status;
+	if (_motorController->GetMotionProfileStatus(status) != OKAY)
+		return;
+	Sample(status, MonotonicClock::NowUs() * 1e-6);
+}
+
+} // namespace motion
+} // namespace phoenix
+} // namespace ctre
@@ -0,0 +1,126 @@
+#include "ctre/phoenix/Motion/PreparedMotionProfile.h"
+#include <vector>
+
+namespace ctre {
+namespace phoenix {
+namespace motion {
+
+/**
+ * Encode a profile from caller's trajectory points.  Flags are taken as-is
+ * from each point.
+ * @param points array of trajectory points.
+ * @param count number of points in array.
+ */
+void PreparedMotionProfile::Prepare(const TrajectoryPoint * points,
+		int count) {
+	_pts.clear();
+	_pts.reserve(count);
+	for (int i = 0; i < count; ++i) {
+		_pts.push_back(CompactTrajectoryPoint::FromTrajectoryPoint(points[i]));
+	}
+}
+void PreparedMotionProfile::Prepare(
+		const std::vector<TrajectoryPoint> & points) {
+	Prepare(points.data(), (int) points.size());
+}
+/**
+ * Encode a profile from parallel arrays, typically generated offline.
+ * The final point is flagged as the last point.
+ * @param positions servo positions in sensor units.
+ * @param velocities velocities to feed-forward in sensor units per 100ms.
+ * @param headingsDeg headings in degrees, pass null if not used.
+ * @param count number of points.
+ * @param profileSlotSelect which slot to pull PIDF gains from.
+ * @param zeroPosOnFirst set to zero the selected sensor on the first point.
+ */
+void PreparedMotionProfile::Prepare(const double positions[],
+		const double velocities[], const double headingsDeg[], int count,
+		int profileSlotSelect, bool zeroPosOnFirst) {
+	_pts.clear();
+	_pts.reserve(count);
+
+	TrajectoryPoint pt;
+	pt.profileSlotSelect = profileSlotSelect;
+	for (int i = 0; i < count; ++i) {
+		pt.position = positions[i];
+		pt.velocity = velocities[i];
+		pt.headingDeg = (headingsDeg != nullptr) ? headingsDeg[i] : 0;
+		pt.zeroPos = zeroPosOnFirst && (i == 0);
+		pt.isLastPoint = (i + 1 == count);
+		_pts.push_back(CompactTrajectoryPoint::FromTrajectoryPoint(pt));
+	}
+}
+/**
+ * Replace every point from fromIndex onward with a new segment.
+ * To keep position and velocity continuous at the splice point, the first
+ * blendPoints of the new segment are cross-faded from the points they
+ * replace (or the last kept point if the old profile was shorter).
+ * @param fromIndex first index to replace, capped to the current count.
+ * @param points new segment.
+ * @param count number of points in new segment, 0 (or negative) just
+ *              truncates the profile at fromIndex.
+ * @param blendPoints number of points to cross-fade over, 0 for a hard cut.
+ *                    Clamped to [0, count].
+ */
+void PreparedMotionProfile::Splice(int fromIndex,
+		const TrajectoryPoint * points, int count, int blendPoints) {
+	if (count < 0)
+		count = 0;
+	int oldCount = (int) _pts.size();
+	if (fromIndex < 0)
+		fromIndex = 0;
+	if (fromIndex > oldCount)
+		fromIndex = oldCount;
+	if (blendPoints < 0)
+		blendPoints = 0;
+	if (blendPoints > count)
+		blendPoints = count;
+	if (fromIndex == 0 && oldCount == 0)
+		blendPoints = 0; /* nothing to blend from */
+	/* copy the points being blended from before the loop overwrites them */
+	std::vector<TrajectoryPoint> oldPts(blendPoints);
+	for (int i = 0; i < blendPoints; ++i) {
+		/* point being replaced, or last kept point */
+		int oldIdx = fromIndex + i;
+		if (oldIdx >= oldCount)
+			oldIdx = oldCount - 1;
+		_pts[oldIdx].ToTrajectoryPoint(oldPts[i]);
+	}
+	for (int i = 0; i < count; ++i) {
+		TrajectoryPoint pt = points[i];
+
+		if (i < blendPoints) {
+			const TrajectoryPoint & old = oldPts[i];
+
+			/* weight of old profile goes from ~1 down to ~0 */
+			double w = 1.0 - (double) (i + 1) / (blendPoints + 1);
+			pt.position += w * (old.position - pt.position);
+			pt.velocity += w * (old.velocity - pt.velocity);
+			pt.headingDeg += w * (old.headingDeg - pt.headingDeg);
+		}
+
+		CompactTrajectoryPoint cpt = CompactTrajectoryPoint::FromTrajectoryPoint(pt);
+		int idx = fromIndex + i;
+		if (idx < oldCount)
+			_pts[idx] = cpt;
+		else
+			_pts.push_back(cpt);
+	}
+	/* drop whatever is left of the old tail */
+	if (fromIndex + count < oldCount)
+		_pts.resize(fromIndex + count);
+	/* whatever survived, only the final point may end the profile */
+	if (!_pts.empty()) {
+		int first = (fromIndex > 0) ? fromIndex - 1 : 0;
+		for (int i = first; i + 1 < (int) _pts.size(); ++i)
+			_pts[i].isLastPoint = 0;
+		_pts.back().isLastPoint = 1;
+	}
+}
+void PreparedMotionProfile::Clear() {
+	_pts.clear();
+}
+
+} // namespace motion
+} // namespace phoenix
+} // namespace ctre
@@ -0,0 +1,70 @@
+#include "ctre/phoenix/Motion/Sim/DCMotorPlant.h"
+
+namespace ctre {
+namespace phoenix {
+namespace motion {
+namespace sim {
+
+static const double kTwoPi = 6.283185307179586;
+
+/**
+ * Constructor
+ * @param params motor, gearbox, load and sensor description.
+ */
+DCMotorPlant::DCMotorPlant(const Params & params) :
+		_params(params) {
+	_resistance = _params.nominalVoltage / _params.stallCurrentAmps;
+	_kT = _params.stallTorqueNm / _params.stallCurrentAmps;
+	double freeSpeedRadPerSec = _params.freeSpeedRpm * kTwoPi / 60.0;
+	_kV = freeSpeedRadPerSec
+			/ (_params.nominalVoltage - _resistance * _params.freeCurrentAmps);
+}
+/**
+ * Advance the model.
+ * @param outputPercent applied output [-1,1].
+ * @param busVoltage supply voltage.
+ * @param dtSec time step, keep at or below 1ms for stable integration.
+ */
+void DCMotorPlant::Step(double outputPercent, double busVoltage,
+		double dtSec) {
+	double volts = outputPercent * busVoltage;
+	double motorRadPerSec = _velocityRadPerSec * _params.gearRatio;
+
+	/* per motor current from back-emf */
+	double amps = (volts - motorRadPerSec / _kV) / _resistance;
+	_currentAmps = amps * _params.motorCount;
+
+	double torque = _currentAmps * _kT * _params.gearRatio
+			- _params.viscousDamping * _velocityRadPerSec;
+	double accel = torque / _params.momentOfInertia;
+
+	/* semi-implicit euler */
+	_velocityRadPerSec += accel * dtSec;
+	_positionRad += _velocityRadPerSec * dtSec;
+}
+void DCMotorPlant::Reset() {
+	_positionRad = 0;
+	_velocityRadPerSec = 0;
+	_zeroOffsetRad = 0;
+	_currentAmps = 0;
+}
+/**
+ * Zero the sensor, mechanism keeps moving.
+ */
+void DCMotorPlant::ZeroPosition() {
+	_zeroOffsetRad = _positionRad;
+}
+double DCMotorPlant::GetPositionUnits() const {
+	return (_positionRad - _zeroOffsetRad) / kTwoPi * _params.sensorUnitsPerRev;
+}
+double DCMotorPlant::GetVelocityUnitsPer100ms() const {
+	return _velocityRadPerSec / kTwoPi * _params.sensorUnitsPerRev * 0.1;
+}
+double DCMotorPlant::GetCurrentAmps() const {
+	return _currentAmps;
+}
+
+} // namespace sim
+} // namespace motion
+} // namespace phoenix
+} // namespace ctre
@@ -0,0 +1,241 @@
+#include "ctre/phoenix/Motion/Sim/MotionProfileExecutorSim.h"
+#include <cmath>
+
+namespace ctre {
+namespace phoenix {
+namespace motion {
+namespace sim {
+
+double MotionProfileExecutorSim::Stats::GetRmsError() const {
+	if (errorSamples == 0)
+		return 0;
+	return std::sqrt(sumSqError / errorSamples);
+}
+
+/**
+ * Constructor
+ * @param plant model that the simulated controller drives.
+ */
+MotionProfileExecutorSim::MotionProfileExecutorSim(DCMotorPlant * plant) {
+	_plant = plant;
+}
+/**
+ * @param slotIdx [0,3]
+ * @param gains PIDF gains in controller units, same values as Config_kP() etc.
+ */
+void MotionProfileExecutorSim::ConfigSlot(int slotIdx,
+		const SlotGains & gains) {
+	if (slotIdx >= 0 && slotIdx < kSlotCount)
+		_slots[slotIdx] = gains;
+}
+void MotionProfileExecutorSim::ConfigPeakOutput(double percentOut) {
+	_peakOutput = percentOut;
+}
+void MotionProfileExecutorSim::SetBusVoltage(double volts) {
+	_busVoltage = volts;
+}
+/**
+ * @param durationMs duration used for points pushed without a duration.
+ */
+void MotionProfileExecutorSim::SetTrajectoryPeriod(int durationMs) {
+	_defaultDurationMs = durationMs;
+}
+/**
+ * Buffer a point.  Unlike the controller there is no top/bottom split, all
+ * points are immediately available to the executer.
+ * @param trajPt point to buffer.
+ * @param durationMs how long to execute this point, zero for the trajectory period.
+ * @return true if buffered.
+ */
+bool MotionProfileExecutorSim::PushMotionProfileTrajectory(
+		const TrajectoryPoint & trajPt, int durationMs) {
+	SimPoint sp;
+	sp.pt = trajPt;
+	sp.durationMs = (durationMs > 0) ? durationMs : _defaultDurationMs;
+	_buffer.push_back(sp);
+	return true;
+}
+void MotionProfileExecutorSim::ClearMotionProfileTrajectories() {
+	_buffer.clear();
+	_bufferIdx = 0;
+	_activeValid = false;
+}
+void MotionProfileExecutorSim::SetOutputEnable(
+		SetValueMotionProfile outputEnable) {
+	_outputEnable = outputEnable;
+}
+/**
+ * Restart the model and clear statistics.  Gains and buffered points are kept
+ * so the same profile can be run again.
+ */
+void MotionProfileExecutorSim::Reset() {
+	_plant->Reset();
+	_bufferIdx = 0;
+	_activeValid = false;
+	_activeRemainingMs = 0;
+	_isUnderrun = false;
+	_hasUnderrun = false;
+	_iAccum = 0;
+	_lastError = 0;
+	_closedLoopError = 0;
+	_output = 0;
+	_stats = Stats();
+}
+bool MotionProfileExecutorSim::PopNextPoint() {
+	if (_bufferIdx >= _buffer.size())
+		return false;
+	_active = _buffer[_bufferIdx++];
+	_activeRemainingMs = _active.durationMs;
+	_activeValid = true;
+	++_stats.pointsExecuted;
+	if (_active.pt.zeroPos)
+		_plant->ZeroPosition();
+	return true;
+}
+void MotionProfileExecutorSim::ServoActivePoint() {
+	const SlotGains & g = _slots[_active.pt.profileSlotSelect % kSlotCount];
+
+	double err = _active.pt.position - _plant->GetPositionUnits();
+	if (g.integralZone != 0 && std::fabs(err) > g.integralZone)
+		_iAccum = 0;
+	else
+		_iAccum += err;
+
+	double out = g.kP * err + g.kI * _iAccum + g.kD * (err - _lastError)
+			+ g.kF * _active.pt.velocity;
+	_lastError = err;
+	_closedLoopError = err;
+
+	double peak = 1023 * _peakOutput;
+	if (out > peak)
+		out = peak;
+	if (out < -peak)
+		out = -peak;
+	_output = out / 1023;
+
+	double absErr = std::fabs(err);
+	if (absErr > _stats.maxAbsError)
+		_stats.maxAbsError = absErr;
+	_stats.sumSqError += err * err;
+	++_stats.errorSamples;
+}
+/**
+ * Advance the controller and plant by one 1ms control loop.
+ */
+void MotionProfileExecutorSim::Step() {
+	switch (_outputEnable) {
+	case SetValueMotionProfile::Enable:
+		if (!_activeValid) {
+			PopNextPoint();
+		} else if (_activeRemainingMs <= 0 && !_active.pt.isLastPoint) {
+			if (PopNextPoint()) {
+				_isUnderrun = false;
+			} else {
+				/* keep servoing the active point until more arrive */
+				_isUnderrun = true;
+				_hasUnderrun = true;
+			}
+		}
+		break;
+	case SetValueMotionProfile::Hold:
+		break;
+	case SetValueMotionProfile::Disable:
+	default:
+		/* nothing is executing, so nothing can be starved of points */
+		_activeValid = false;
+		_isUnderrun = false;
+		break;
+	}
+
+	if (_activeValid) {
+		ServoActivePoint();
+		if (_outputEnable == SetValueMotionProfile::Enable)
+			_activeRemainingMs -= kLoopPeriodMs;
+	} else {
+		_output = 0;
+		_iAccum = 0;
+		_lastError = 0;
+	}
+	if (_isUnderrun)
+		_stats.underrunMs += kLoopPeriodMs;
+
+	_plant->Step(_output, _busVoltage, kLoopPeriodMs * 0.001);
+
+	double amps = std::fabs(_plant->GetCurrentAmps());
+	if (amps > _stats.peakCurrentAmps)
+		_stats.peakCurrentAmps = amps;
+	_stats.elapsedMs += kLoopPeriodMs;
+}
+/**
+ * Run for a fixed amount of simulated time.
+ * @return simulated ms elapsed.
+ */
+int MotionProfileExecutorSim::Run(int durationMs) {
+	int ms = 0;
+	while (ms < durationMs) {
+		Step();
+		ms += kLoopPeriodMs;
+	}
+	return ms;
+}
+bool MotionProfileExecutorSim::IsDone() const {
+	if (!_activeValid)
+		return false;
+	if (_active.pt.isLastPoint)
+		return true;
+	/* ran out of points and there is no last point to hold */
+	return _isUnderrun && (_bufferIdx >= _buffer.size());
+}
+/**
+ * Run until the last point becomes active, or the buffer empties.
+ * @param timeoutMs give up after this much simulated time.
+ * @return simulated ms elapsed.
+ */
+int MotionProfileExecutorSim::RunUntilDone(int timeoutMs) {
+	int ms = 0;
+	while (ms < timeoutMs && !IsDone()) {
+		Step();
+		ms += kLoopPeriodMs;
+	}
+	return ms;
+}
+void MotionProfileExecutorSim::GetMotionProfileStatus(
+		MotionProfileStatus & statusToFill) const {
+	int remaining = (int) (_buffer.size() - _bufferIdx);
+	statusToFill.topBufferRem = 0;
+	statusToFill.topBufferCnt = 0;
+	statusToFill.btmBufferCnt = remaining;
+	statusToFill.hasUnderrun = _hasUnderrun;
+	statusToFill.isUnderrun = _isUnderrun;
+	statusToFill.activePointValid = _activeValid;
+	statusToFill.isLast = _activeValid && _active.pt.isLastPoint;
+	statusToFill.profileSlotSelect =
+			_activeValid ? _active.pt.profileSlotSelect : 0;
+	statusToFill.outputEnable = _outputEnable;
+}
+double MotionProfileExecutorSim::GetMotorOutputPercent() const {
+	return _output;
+}
+int MotionProfileExecutorSim::GetSelectedSensorPosition() const {
+	return (int) _plant->GetPositionUnits();
+}
+int MotionProfileExecutorSim::GetSelectedSensorVelocity() const {
+	return (int) _plant->GetVelocityUnitsPer100ms();
+}
+double MotionProfileExecutorSim::GetClosedLoopError() const {
+	return _closedLoopError;
+}
+int MotionProfileExecutorSim::GetActiveTrajectoryPosition() const {
+	return _activeValid ? (int) _active.pt.position : 0;
+}
+int MotionProfileExecutorSim::GetActiveTrajectoryVelocity() const {
+	return _activeValid ? (int) _active.pt.velocity : 0;
+}
+const MotionProfileExecutorSim::Stats & MotionProfileExecutorSim::GetStats() const {
+	return _stats;
+}
+
+} // namespace sim
+} // namespace motion
+} // namespace phoenix
+} // namespace ctre
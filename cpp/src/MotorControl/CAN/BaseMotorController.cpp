@@ -1,6 +1,7 @@
 ﻿#include "ctre/phoenix/MotorControl/CAN/BaseMotorController.h"
 #include "ctre/phoenix/MotorControl/SensorCollection.h"
 #include "ctre/phoenix/CCI/MotController_CCI.h"
+#include "ctre/phoenix/ErrorCounters.h"
 #include "ctre/phoenix/LowLevel/MotControllerWithBuffer_LowLevel.h"
 
 using namespace ctre::phoenix;
@@ -17,6 +18,11 @@ using namespace ctre::phoenix::motorcontrol::lowlevel;
 BaseMotorController::BaseMotorController(int arbId) {
 	m_handle = c_MotController_Create1(arbId);
 	_arbId = arbId;
+	/* device type is in the upper byte of the arbitration ID */
+	ErrorCounters::Register(m_handle,
+			((arbId >> 24) == 0x02) ?
+					ErrorCounters::TalonSRX : ErrorCounters::VictorSPX,
+			arbId & 0x3F);
 
 	_sensorColl = new motorcontrol::SensorCollection((void*) m_handle);
 }
@@ -25,6 +31,7 @@ BaseMotorController::BaseMotorController(int arbId) {
  * Destructor
  */
 BaseMotorController::~BaseMotorController() {
+	ErrorCounters::Unregister(m_handle);
 	delete _sensorColl;
 	_sensorColl = 0;
 }
@@ -41,7 +48,7 @@ void* BaseMotorController::GetHandle() {
  */
 int BaseMotorController::GetDeviceID() {
 	int devID = 0;
-	(void) c_MotController_GetDeviceNumber(m_handle, &devID);
+	(void) ErrorCounters::Count(m_handle, c_MotController_GetDeviceNumber(m_handle, &devID));
 	return devID;
 }
 //------ Set output routines. ----------//
@@ -77,16 +84,11 @@ void BaseMotorController::Set(ControlMode Mode, double value) {
  */
 void BaseMotorController::Set(ControlMode mode, double demand0,
 		double demand1) {
-	m_controlMode = mode;
-	m_sendMode = mode;
-	m_setPoint = demand0;
-
 	uint32_t work;
-	switch (m_controlMode) {
+	switch (mode) {
 	case ControlMode::PercentOutput:
 		//case ControlMode::TimedPercentOutput:
-		c_MotController_SetDemand(m_handle, (int) m_sendMode,
-				(int) (1023 * demand0), 1023 * demand1);
+		Set<ControlMode::PercentOutput>(demand0, demand1);
 		break;
 	case ControlMode::Follower:
 		/* did caller specify device ID */
@@ -98,27 +100,48 @@ void BaseMotorController::Set(ControlMode mode, double demand0,
 		} else {
 			work = (uint32_t) demand0;
 		}
-		c_MotController_SetDemand(m_handle, (int) m_sendMode, work, 0);
+		SetEncodedDemand(mode, demand0, work, 0);
 		break;
 	case ControlMode::Velocity:
+		Set<ControlMode::Velocity>(demand0, demand1);
+		break;
 	case ControlMode::Position:
+		Set<ControlMode::Position>(demand0, demand1);
+		break;
 	case ControlMode::MotionMagic:
+		Set<ControlMode::MotionMagic>(demand0, demand1);
+		break;
 	case ControlMode::MotionMagicArc:
+		Set<ControlMode::MotionMagicArc>(demand0, demand1);
+		break;
 	case ControlMode::MotionProfile:
-		c_MotController_SetDemand(m_handle, (int) m_sendMode, (int) (demand0),
-				1023 * demand1);
+		Set<ControlMode::MotionProfile>(demand0, demand1);
 		break;
 	case ControlMode::Current:
-		c_MotController_SetDemand(m_handle, (int) m_sendMode,
-				(int) (1000 * demand0), 0); /* milliamps */
+		Set<ControlMode::Current>(demand0, demand1);
 		break;
 	case ControlMode::Disabled:
 		/* fall thru...*/
 	default:
-		c_MotController_SetDemand(m_handle, (int) m_sendMode, 0, 0);
+		SetEncodedDemand(mode, demand0, 0, 0);
 		break;
 	}
 }
+/**
+ * Record the demand and send it, already converted to frame units.
+ * @param mode control mode to send.
+ * @param setPoint demand in caller units.
+ * @param demand0 encoded demand0.
+ * @param demand1 encoded demand1.
+ */
+void BaseMotorController::SetEncodedDemand(ControlMode mode, double setPoint,
+		int demand0, int demand1) {
+	m_controlMode = mode;
+	m_sendMode = mode;
+	m_setPoint = setPoint;
+	ErrorCounters::Count(m_handle,
+			c_MotController_SetDemand(m_handle, (int) m_sendMode, demand0, demand1));
+}
 /**
  * Neutral the motor output by setting control mode to disabled.
  */
@@ -143,7 +166,7 @@ void BaseMotorController::SetNeutralMode(NeutralMode neutralMode) {
  *	@param enable true/false enable
  */
 void BaseMotorController::EnableHeadingHold(bool enable) {
-	c_MotController_EnableHeadingHold(m_handle, enable);
+	ErrorCounters::Count(m_handle, c_MotController_EnableHeadingHold(m_handle, enable));
 }
 /**
  * For now this simply updates the CAN signal to the motor controller.
@@ -152,7 +175,7 @@ void BaseMotorController::EnableHeadingHold(bool enable) {
  *	@param value
  */
 void BaseMotorController::SelectDemandType(bool value) {
-	c_MotController_SelectDemandType(m_handle, value);
+	ErrorCounters::Count(m_handle, c_MotController_SelectDemandType(m_handle, value));
 }
 
 //------ Invert behavior ----------//
@@ -209,8 +232,8 @@ bool BaseMotorController::GetInverted() const {
  */
 ErrorCode BaseMotorController::ConfigOpenloopRamp(
 		double secondsFromNeutralToFull, int timeoutMs) {
-	return c_MotController_ConfigOpenLoopRamp(m_handle,
-			secondsFromNeutralToFull, timeoutMs);
+	return ErrorCounters::Count(m_handle, c_MotController_ConfigOpenLoopRamp(m_handle,
+			secondsFromNeutralToFull, timeoutMs));
 }
 
 /**
@@ -227,8 +250,8 @@ ErrorCode BaseMotorController::ConfigOpenloopRamp(
  */
 ErrorCode BaseMotorController::ConfigClosedloopRamp(
 		double secondsFromNeutralToFull, int timeoutMs) {
-	return c_MotController_ConfigClosedLoopRamp(m_handle,
-			secondsFromNeutralToFull, timeoutMs);
+	return ErrorCounters::Count(m_handle, c_MotController_ConfigClosedLoopRamp(m_handle,
+			secondsFromNeutralToFull, timeoutMs));
 }
 
 /**
@@ -244,8 +267,9 @@ ErrorCode BaseMotorController::ConfigClosedloopRamp(
  */
 ErrorCode BaseMotorController::ConfigPeakOutputForward(double percentOut,
 		int timeoutMs) {
-	return c_MotController_ConfigPeakOutputForward(m_handle, percentOut,
-			timeoutMs);
+	return ErrorCounters::Count(m_handle,
+			c_MotController_ConfigPeakOutputForward(m_handle, percentOut,
+			timeoutMs));
 }
 
 /**
@@ -261,8 +285,9 @@ ErrorCode BaseMotorController::ConfigPeakOutputForward(double percentOut,
  */
 ErrorCode BaseMotorController::ConfigPeakOutputReverse(double percentOut,
 		int timeoutMs) {
-	return c_MotController_ConfigPeakOutputReverse(m_handle, percentOut,
-			timeoutMs);
+	return ErrorCounters::Count(m_handle,
+			c_MotController_ConfigPeakOutputReverse(m_handle, percentOut,
+			timeoutMs));
 }
 /**
  * Configures the forward nominal output percentage.
@@ -277,8 +302,9 @@ ErrorCode BaseMotorController::ConfigPeakOutputReverse(double percentOut,
  */
 ErrorCode BaseMotorController::ConfigNominalOutputForward(double percentOut,
 		int timeoutMs) {
-	return c_MotController_ConfigNominalOutputForward(m_handle, percentOut,
-			timeoutMs);
+	return ErrorCounters::Count(m_handle,
+			c_MotController_ConfigNominalOutputForward(m_handle, percentOut,
+			timeoutMs));
 }
 /**
  * Configures the reverse nominal output percentage.
@@ -293,8 +319,9 @@ ErrorCode BaseMotorController::ConfigNominalOutputForward(double percentOut,
  */
 ErrorCode BaseMotorController::ConfigNominalOutputReverse(double percentOut,
 		int timeoutMs) {
-	return c_MotController_ConfigNominalOutputReverse(m_handle, percentOut,
-			timeoutMs);
+	return ErrorCounters::Count(m_handle,
+			c_MotController_ConfigNominalOutputReverse(m_handle, percentOut,
+			timeoutMs));
 }
 /**
  * Configures the output deadband percentage.
@@ -310,8 +337,9 @@ ErrorCode BaseMotorController::ConfigNominalOutputReverse(double percentOut,
  */
 ErrorCode BaseMotorController::ConfigNeutralDeadband(double percentDeadband,
 		int timeoutMs) {
-	return c_MotController_ConfigNeutralDeadband(m_handle, percentDeadband,
-			timeoutMs);
+	return ErrorCounters::Count(m_handle,
+			c_MotController_ConfigNeutralDeadband(m_handle, percentDeadband,
+			timeoutMs));
 }
 
 //------ Voltage Compensation ----------//
@@ -331,8 +359,9 @@ ErrorCode BaseMotorController::ConfigNeutralDeadband(double percentDeadband,
  */
 ErrorCode BaseMotorController::ConfigVoltageCompSaturation(double voltage,
 		int timeoutMs) {
-	return c_MotController_ConfigVoltageCompSaturation(m_handle, voltage,
-			timeoutMs);
+	return ErrorCounters::Count(m_handle,
+			c_MotController_ConfigVoltageCompSaturation(m_handle, voltage,
+			timeoutMs));
 }
 
 /**
@@ -349,8 +378,8 @@ ErrorCode BaseMotorController::ConfigVoltageCompSaturation(double voltage,
  */
 ErrorCode BaseMotorController::ConfigVoltageMeasurementFilter(
 		int filterWindowSamples, int timeoutMs) {
-	return c_MotController_ConfigVoltageMeasurementFilter(m_handle,
-			filterWindowSamples, timeoutMs);
+	return ErrorCounters::Count(m_handle, c_MotController_ConfigVoltageMeasurementFilter(m_handle,
+			filterWindowSamples, timeoutMs));
 }
 
 /**
@@ -372,7 +401,7 @@ void BaseMotorController::EnableVoltageCompensation(bool enable) {
  */
 double BaseMotorController::GetBusVoltage() {
 	double param = 0;
-	c_MotController_GetBusVoltage(m_handle, &param);
+	ErrorCounters::Count(m_handle, c_MotController_GetBusVoltage(m_handle, &param));
 	return param;
 }
 
@@ -383,7 +412,7 @@ double BaseMotorController::GetBusVoltage() {
  */
 double BaseMotorController::GetMotorOutputPercent() {
 	double param = 0;
-	c_MotController_GetMotorOutputPercent(m_handle, &param);
+	ErrorCounters::Count(m_handle, c_MotController_GetMotorOutputPercent(m_handle, &param));
 	return param;
 }
 
@@ -401,7 +430,7 @@ double BaseMotorController::GetMotorOutputVoltage() {
  */
 double BaseMotorController::GetOutputCurrent() {
 	double param = 0;
-	c_MotController_GetOutputCurrent(m_handle, &param);
+	ErrorCounters::Count(m_handle, c_MotController_GetOutputCurrent(m_handle, &param));
 	return param;
 }
 /**
@@ -411,7 +440,7 @@ double BaseMotorController::GetOutputCurrent() {
  */
 double BaseMotorController::GetTemperature() {
 	double param = 0;
-	c_MotController_GetTemperature(m_handle, &param);
+	ErrorCounters::Count(m_handle, c_MotController_GetTemperature(m_handle, &param));
 	return param;
 }
 
@@ -432,8 +461,8 @@ double BaseMotorController::GetTemperature() {
  */
 ErrorCode BaseMotorController::ConfigSelectedFeedbackSensor(
 		RemoteFeedbackDevice feedbackDevice, int pidIdx, int timeoutMs) {
-	return c_MotController_ConfigSelectedFeedbackSensor(m_handle,
-			feedbackDevice, pidIdx, timeoutMs);
+	return ErrorCounters::Count(m_handle, c_MotController_ConfigSelectedFeedbackSensor(m_handle,
+			feedbackDevice, pidIdx, timeoutMs));
 }
 /**
  * Select the feedback device for the motor controller.
@@ -450,8 +479,8 @@ ErrorCode BaseMotorController::ConfigSelectedFeedbackSensor(
  */
 ErrorCode BaseMotorController::ConfigSelectedFeedbackSensor(
 		FeedbackDevice feedbackDevice, int pidIdx, int timeoutMs) {
-	return c_MotController_ConfigSelectedFeedbackSensor(m_handle,
-			feedbackDevice, pidIdx, timeoutMs);
+	return ErrorCounters::Count(m_handle, c_MotController_ConfigSelectedFeedbackSensor(m_handle,
+			feedbackDevice, pidIdx, timeoutMs));
 }
 /**
  * Select what remote device and signal to assign to Remote Sensor 0 or Remote Sensor 1.
@@ -474,8 +503,9 @@ ErrorCode BaseMotorController::ConfigSelectedFeedbackSensor(
 ErrorCode BaseMotorController::ConfigRemoteFeedbackFilter(int deviceID,
 		RemoteSensorSource remoteSensorSource, int remoteOrdinal,
 		int timeoutMs) {
-	return c_MotController_ConfigRemoteFeedbackFilter(m_handle, deviceID,
-			(int) remoteSensorSource, remoteOrdinal, timeoutMs);
+	return ErrorCounters::Count(m_handle,
+			c_MotController_ConfigRemoteFeedbackFilter(m_handle, deviceID,
+			(int) remoteSensorSource, remoteOrdinal, timeoutMs));
 }
 /**
  * Select what sensor term should be bound to switch feedback device.
@@ -494,8 +524,9 @@ ErrorCode BaseMotorController::ConfigRemoteFeedbackFilter(int deviceID,
  */
 ErrorCode BaseMotorController::ConfigSensorTerm(SensorTerm sensorTerm,
 		FeedbackDevice feedbackDevice, int timeoutMs) {
-	return c_MotController_ConfigSensorTerm(m_handle, (int) sensorTerm,
-			(int) feedbackDevice, timeoutMs);
+	return ErrorCounters::Count(m_handle,
+			c_MotController_ConfigSensorTerm(m_handle, (int) sensorTerm,
+			(int) feedbackDevice, timeoutMs));
 }
 //------- sensor status --------- //
 /**
@@ -508,7 +539,8 @@ ErrorCode BaseMotorController::ConfigSensorTerm(SensorTerm sensorTerm,
  */
 int BaseMotorController::GetSelectedSensorPosition(int pidIdx) {
 	int retval;
-	c_MotController_GetSelectedSensorPosition(m_handle, &retval, pidIdx);
+	ErrorCounters::Count(m_handle,
+			c_MotController_GetSelectedSensorPosition(m_handle, &retval, pidIdx));
 	return retval;
 }
 /**
@@ -521,7 +553,8 @@ int BaseMotorController::GetSelectedSensorPosition(int pidIdx) {
  */
 int BaseMotorController::GetSelectedSensorVelocity(int pidIdx) {
 	int retval;
-	c_MotController_GetSelectedSensorVelocity(m_handle, &retval, pidIdx);
+	ErrorCounters::Count(m_handle,
+			c_MotController_GetSelectedSensorVelocity(m_handle, &retval, pidIdx));
 	return retval;
 }
 /**
@@ -539,8 +572,9 @@ int BaseMotorController::GetSelectedSensorVelocity(int pidIdx) {
  */
 ErrorCode BaseMotorController::SetSelectedSensorPosition(int sensorPos,
 		int pidIdx, int timeoutMs) {
-	return c_MotController_SetSelectedSensorPosition(m_handle, sensorPos,
-			pidIdx, timeoutMs);
+	return ErrorCounters::Count(m_handle,
+			c_MotController_SetSelectedSensorPosition(m_handle, sensorPos,
+			pidIdx, timeoutMs));
 }
 
 //------ status frame period changes ----------//
@@ -555,7 +589,8 @@ ErrorCode BaseMotorController::SetSelectedSensorPosition(int sensorPos,
  */
 ErrorCode BaseMotorController::SetControlFramePeriod(ControlFrame frame,
 		int periodMs) {
-	return c_MotController_SetControlFramePeriod(m_handle, frame, periodMs);
+	return ErrorCounters::Count(m_handle,
+			c_MotController_SetControlFramePeriod(m_handle, frame, periodMs));
 }
 /**
  * Sets the period of the given status frame.
@@ -578,8 +613,9 @@ ErrorCode BaseMotorController::SetControlFramePeriod(ControlFrame frame,
  */
 ErrorCode BaseMotorController::SetStatusFramePeriod(StatusFrame frame,
 		int periodMs, int timeoutMs) {
-	return c_MotController_SetStatusFramePeriod(m_handle, frame, periodMs,
-			timeoutMs);
+	return ErrorCounters::Count(m_handle,
+			c_MotController_SetStatusFramePeriod(m_handle, frame, periodMs,
+			timeoutMs));
 }
 /**
  * Sets the period of the given status frame.
@@ -602,8 +638,9 @@ ErrorCode BaseMotorController::SetStatusFramePeriod(StatusFrame frame,
  */
 ErrorCode BaseMotorController::SetStatusFramePeriod(StatusFrameEnhanced frame,
 		int periodMs, int timeoutMs) {
-	return c_MotController_SetStatusFramePeriod(m_handle, frame, periodMs,
-			timeoutMs);
+	return ErrorCounters::Count(m_handle,
+			c_MotController_SetStatusFramePeriod(m_handle, frame, periodMs,
+			timeoutMs));
 }
 /**
  * Gets the period of the given status frame.
@@ -619,7 +656,8 @@ ErrorCode BaseMotorController::SetStatusFramePeriod(StatusFrameEnhanced frame,
 int BaseMotorController::GetStatusFramePeriod(StatusFrame frame,
 		int timeoutMs) {
 	int periodMs = 0;
-	c_MotController_GetStatusFramePeriod(m_handle, frame, &periodMs, timeoutMs);
+	ErrorCounters::Count(m_handle,
+			c_MotController_GetStatusFramePeriod(m_handle, frame, &periodMs, timeoutMs));
 	return periodMs;
 }
 
@@ -637,7 +675,8 @@ int BaseMotorController::GetStatusFramePeriod(StatusFrame frame,
 int BaseMotorController::GetStatusFramePeriod(StatusFrameEnhanced frame,
 		int timeoutMs) {
 	int periodMs = 0;
-	c_MotController_GetStatusFramePeriod(m_handle, frame, &periodMs, timeoutMs);
+	ErrorCounters::Count(m_handle,
+			c_MotController_GetStatusFramePeriod(m_handle, frame, &periodMs, timeoutMs));
 	return periodMs;
 }
 
@@ -660,8 +699,9 @@ int BaseMotorController::GetStatusFramePeriod(StatusFrameEnhanced frame,
  */
 ErrorCode BaseMotorController::ConfigVelocityMeasurementPeriod(
 		VelocityMeasPeriod period, int timeoutMs) {
-	return c_MotController_ConfigVelocityMeasurementPeriod(m_handle, period,
-			timeoutMs);
+	return ErrorCounters::Count(m_handle,
+			c_MotController_ConfigVelocityMeasurementPeriod(m_handle, period,
+			timeoutMs));
 }
 /**
  * Sets the number of velocity samples used in the rolling average velocity
@@ -679,8 +719,9 @@ ErrorCode BaseMotorController::ConfigVelocityMeasurementPeriod(
  */
 ErrorCode BaseMotorController::ConfigVelocityMeasurementWindow(int windowSize,
 		int timeoutMs) {
-	return c_MotController_ConfigVelocityMeasurementWindow(m_handle, windowSize,
-			timeoutMs);
+	return ErrorCounters::Count(m_handle,
+			c_MotController_ConfigVelocityMeasurementWindow(m_handle, windowSize,
+			timeoutMs));
 }
 
 //------ remote limit switch ----------//
@@ -707,8 +748,9 @@ ErrorCode BaseMotorController::ConfigForwardLimitSwitchSource(
 		RemoteLimitSwitchSource type, LimitSwitchNormal normalOpenOrClose,
 		int deviceID, int timeoutMs) {
 	LimitSwitchSource cciType = LimitSwitchRoutines::Promote(type);
-	return c_MotController_ConfigForwardLimitSwitchSource(m_handle, cciType,
-			normalOpenOrClose, deviceID, timeoutMs);
+	return ErrorCounters::Count(m_handle,
+			c_MotController_ConfigForwardLimitSwitchSource(m_handle, cciType,
+			normalOpenOrClose, deviceID, timeoutMs));
 }
 /**
  * Configures the reverse limit switch for a remote source.
@@ -733,8 +775,9 @@ ErrorCode BaseMotorController::ConfigReverseLimitSwitchSource(
 		RemoteLimitSwitchSource type, LimitSwitchNormal normalOpenOrClose,
 		int deviceID, int timeoutMs) {
 	LimitSwitchSource cciType = LimitSwitchRoutines::Promote(type);
-	return c_MotController_ConfigReverseLimitSwitchSource(m_handle, cciType,
-			normalOpenOrClose, deviceID, timeoutMs);
+	return ErrorCounters::Count(m_handle,
+			c_MotController_ConfigReverseLimitSwitchSource(m_handle, cciType,
+			normalOpenOrClose, deviceID, timeoutMs));
 }
 /**
  * Sets the enable state for limit switches.
@@ -779,8 +822,9 @@ void BaseMotorController::OverrideLimitSwitchesEnable(bool enable) {
 ErrorCode BaseMotorController::ConfigForwardLimitSwitchSource(
 		LimitSwitchSource type, LimitSwitchNormal normalOpenOrClose,
 		int timeoutMs) {
-	return c_MotController_ConfigForwardLimitSwitchSource(m_handle, type,
-			normalOpenOrClose, 0, timeoutMs);
+	return ErrorCounters::Count(m_handle,
+			c_MotController_ConfigForwardLimitSwitchSource(m_handle, type,
+			normalOpenOrClose, 0, timeoutMs));
 }
 /**
  * Configures a limit switch for a local/remote source.
@@ -806,8 +850,9 @@ ErrorCode BaseMotorController::ConfigForwardLimitSwitchSource(
 ErrorCode BaseMotorController::ConfigReverseLimitSwitchSource(
 		LimitSwitchSource type, LimitSwitchNormal normalOpenOrClose,
 		int timeoutMs) {
-	return c_MotController_ConfigReverseLimitSwitchSource(m_handle, type,
-			normalOpenOrClose, 0, timeoutMs);
+	return ErrorCounters::Count(m_handle,
+			c_MotController_ConfigReverseLimitSwitchSource(m_handle, type,
+			normalOpenOrClose, 0, timeoutMs));
 }
 
 //------ soft limit ----------//
@@ -824,8 +869,9 @@ ErrorCode BaseMotorController::ConfigReverseLimitSwitchSource(
  */
 ErrorCode BaseMotorController::ConfigForwardSoftLimitThreshold(int forwardSensorLimit,
 		int timeoutMs) {
-	return c_MotController_ConfigForwardSoftLimitThreshold(m_handle, forwardSensorLimit,
-			timeoutMs);
+	return ErrorCounters::Count(m_handle,
+			c_MotController_ConfigForwardSoftLimitThreshold(m_handle, forwardSensorLimit,
+			timeoutMs));
 }
 
 /**
@@ -841,8 +887,9 @@ ErrorCode BaseMotorController::ConfigForwardSoftLimitThreshold(int forwardSensor
  */
 ErrorCode BaseMotorController::ConfigReverseSoftLimitThreshold(int reverseSensorLimit,
 		int timeoutMs) {
-	return c_MotController_ConfigReverseSoftLimitThreshold(m_handle, reverseSensorLimit,
-			timeoutMs);
+	return ErrorCounters::Count(m_handle,
+			c_MotController_ConfigReverseSoftLimitThreshold(m_handle, reverseSensorLimit,
+			timeoutMs));
 }
 
 /**
@@ -858,8 +905,9 @@ ErrorCode BaseMotorController::ConfigReverseSoftLimitThreshold(int reverseSensor
  */
 ErrorCode BaseMotorController::ConfigForwardSoftLimitEnable(bool enable,
 		int timeoutMs) {
-	return c_MotController_ConfigForwardSoftLimitEnable(m_handle, enable,
-			timeoutMs);
+	return ErrorCounters::Count(m_handle,
+			c_MotController_ConfigForwardSoftLimitEnable(m_handle, enable,
+			timeoutMs));
 }
 
 
@@ -876,8 +924,9 @@ ErrorCode BaseMotorController::ConfigForwardSoftLimitEnable(bool enable,
  */
 ErrorCode BaseMotorController::ConfigReverseSoftLimitEnable(bool enable,
 		int timeoutMs) {
-	return c_MotController_ConfigReverseSoftLimitEnable(m_handle, enable,
-			timeoutMs);
+	return ErrorCounters::Count(m_handle,
+			c_MotController_ConfigReverseSoftLimitEnable(m_handle, enable,
+			timeoutMs));
 }
 
 /**
@@ -911,7 +960,8 @@ void BaseMotorController::OverrideSoftLimitsEnable(bool enable) {
  */
 ErrorCode BaseMotorController::Config_kP(int slotIdx, double value,
 		int timeoutMs) {
-	return c_MotController_Config_kP(m_handle, slotIdx, value, timeoutMs);
+	return ErrorCounters::Count(m_handle,
+			c_MotController_Config_kP(m_handle, slotIdx, value, timeoutMs));
 }
 
 /**
@@ -929,7 +979,8 @@ ErrorCode BaseMotorController::Config_kP(int slotIdx, double value,
  */
 ErrorCode BaseMotorController::Config_kI(int slotIdx, double value,
 		int timeoutMs) {
-	return c_MotController_Config_kI(m_handle, slotIdx, value, timeoutMs);
+	return ErrorCounters::Count(m_handle,
+			c_MotController_Config_kI(m_handle, slotIdx, value, timeoutMs));
 }
 
 /**
@@ -947,7 +998,8 @@ ErrorCode BaseMotorController::Config_kI(int slotIdx, double value,
  */
 ErrorCode BaseMotorController::Config_kD(int slotIdx, double value,
 		int timeoutMs) {
-	return c_MotController_Config_kD(m_handle, slotIdx, value, timeoutMs);
+	return ErrorCounters::Count(m_handle,
+			c_MotController_Config_kD(m_handle, slotIdx, value, timeoutMs));
 }
 
 /**
@@ -965,7 +1017,8 @@ ErrorCode BaseMotorController::Config_kD(int slotIdx, double value,
  */
 ErrorCode BaseMotorController::Config_kF(int slotIdx, double value,
 		int timeoutMs) {
-	return c_MotController_Config_kF(m_handle, slotIdx, value, timeoutMs);
+	return ErrorCounters::Count(m_handle,
+			c_MotController_Config_kF(m_handle, slotIdx, value, timeoutMs));
 }
 
 /**
@@ -986,8 +1039,9 @@ ErrorCode BaseMotorController::Config_kF(int slotIdx, double value,
  */
 ErrorCode BaseMotorController::Config_IntegralZone(int slotIdx, int izone,
 		int timeoutMs) {
-	return c_MotController_Config_IntegralZone(m_handle, slotIdx, izone,
-			timeoutMs);
+	return ErrorCounters::Count(m_handle,
+			c_MotController_Config_IntegralZone(m_handle, slotIdx, izone,
+			timeoutMs));
 }
 
 /**
@@ -1006,8 +1060,9 @@ ErrorCode BaseMotorController::Config_IntegralZone(int slotIdx, int izone,
  */
 ErrorCode BaseMotorController::ConfigAllowableClosedloopError(int slotIdx,
 		int allowableCloseLoopError, int timeoutMs) {
-	return c_MotController_ConfigAllowableClosedloopError(m_handle, slotIdx,
-			allowableCloseLoopError, timeoutMs);
+	return ErrorCounters::Count(m_handle,
+			c_MotController_ConfigAllowableClosedloopError(m_handle, slotIdx,
+			allowableCloseLoopError, timeoutMs));
 }
 
 /**
@@ -1025,8 +1080,9 @@ ErrorCode BaseMotorController::ConfigAllowableClosedloopError(int slotIdx,
  */
 ErrorCode BaseMotorController::ConfigMaxIntegralAccumulator(int slotIdx,
 		double iaccum, int timeoutMs) {
-	return c_MotController_ConfigMaxIntegralAccumulator(m_handle, slotIdx,
-			iaccum, timeoutMs);
+	return ErrorCounters::Count(m_handle,
+			c_MotController_ConfigMaxIntegralAccumulator(m_handle, slotIdx,
+			iaccum, timeoutMs));
 }
 
 /**
@@ -1046,8 +1102,9 @@ ErrorCode BaseMotorController::ConfigMaxIntegralAccumulator(int slotIdx,
  */
 ErrorCode BaseMotorController::SetIntegralAccumulator(double iaccum, int pidIdx,
 		int timeoutMs) {
-	return c_MotController_SetIntegralAccumulator(m_handle, iaccum, pidIdx,
-			timeoutMs);
+	return ErrorCounters::Count(m_handle,
+			c_MotController_SetIntegralAccumulator(m_handle, iaccum, pidIdx,
+			timeoutMs));
 }
 
 /**
@@ -1061,7 +1118,8 @@ ErrorCode BaseMotorController::SetIntegralAccumulator(double iaccum, int pidIdx,
  */
 int BaseMotorController::GetClosedLoopError(int pidIdx) {
 	int closedLoopError = 0;
-	c_MotController_GetClosedLoopError(m_handle, &closedLoopError, pidIdx);
+	ErrorCounters::Count(m_handle,
+			c_MotController_GetClosedLoopError(m_handle, &closedLoopError, pidIdx));
 	return closedLoopError;
 }
 
@@ -1073,7 +1131,8 @@ int BaseMotorController::GetClosedLoopError(int pidIdx) {
  */
 double BaseMotorController::GetIntegralAccumulator(int pidIdx) {
 	double iaccum = 0;
-	c_MotController_GetIntegralAccumulator(m_handle, &iaccum, pidIdx);
+	ErrorCounters::Count(m_handle,
+			c_MotController_GetIntegralAccumulator(m_handle, &iaccum, pidIdx));
 	return iaccum;
 }
 
@@ -1087,7 +1146,7 @@ double BaseMotorController::GetIntegralAccumulator(int pidIdx) {
  */
 double BaseMotorController::GetErrorDerivative(int pidIdx) {
 	double derror = 0;
-	c_MotController_GetErrorDerivative(m_handle, &derror, pidIdx);
+	ErrorCounters::Count(m_handle, c_MotController_GetErrorDerivative(m_handle, &derror, pidIdx));
 	return derror;
 }
 
@@ -1100,7 +1159,8 @@ double BaseMotorController::GetErrorDerivative(int pidIdx) {
  *            0 for Primary closed-loop. 1 for cascaded closed-loop.
  **/
 ErrorCode BaseMotorController::SelectProfileSlot(int slotIdx, int pidIdx) {
-	return c_MotController_SelectProfileSlot(m_handle, slotIdx, pidIdx);
+	return ErrorCounters::Count(m_handle,
+			c_MotController_SelectProfileSlot(m_handle, slotIdx, pidIdx));
 }
 /**
  * Gets the current target of a given closed loop.
@@ -1111,7 +1171,7 @@ ErrorCode BaseMotorController::SelectProfileSlot(int slotIdx, int pidIdx) {
  */
 int BaseMotorController::GetClosedLoopTarget(int pidIdx) {
 	int param = 0;
-	c_MotController_GetClosedLoopError(m_handle, &param, pidIdx);
+	ErrorCounters::Count(m_handle, c_MotController_GetClosedLoopError(m_handle, &param, pidIdx));
 	return param;
 }
 /**
@@ -1122,7 +1182,7 @@ int BaseMotorController::GetClosedLoopTarget(int pidIdx) {
  */
 int BaseMotorController::GetActiveTrajectoryPosition() {
 	int param = 0;
-	c_MotController_GetActiveTrajectoryPosition(m_handle, &param);
+	ErrorCounters::Count(m_handle, c_MotController_GetActiveTrajectoryPosition(m_handle, &param));
 	return param;
 }
 /**
@@ -1133,7 +1193,7 @@ int BaseMotorController::GetActiveTrajectoryPosition() {
  */
 int BaseMotorController::GetActiveTrajectoryVelocity() {
 	int param = 0;
-	c_MotController_GetActiveTrajectoryVelocity(m_handle, &param);
+	ErrorCounters::Count(m_handle, c_MotController_GetActiveTrajectoryVelocity(m_handle, &param));
 	return param;
 }
 /**
@@ -1144,7 +1204,7 @@ int BaseMotorController::GetActiveTrajectoryVelocity() {
  */
 double BaseMotorController::GetActiveTrajectoryHeading() {
 	double param = 0;
-	c_MotController_GetActiveTrajectoryHeading(m_handle, &param);
+	ErrorCounters::Count(m_handle, c_MotController_GetActiveTrajectoryHeading(m_handle, &param));
 	return param;
 }
 
@@ -1164,8 +1224,8 @@ double BaseMotorController::GetActiveTrajectoryHeading() {
  */
 ErrorCode BaseMotorController::ConfigMotionCruiseVelocity(
 		int sensorUnitsPer100ms, int timeoutMs) {
-	return c_MotController_ConfigMotionCruiseVelocity(m_handle,
-			sensorUnitsPer100ms, timeoutMs);
+	return ErrorCounters::Count(m_handle, c_MotController_ConfigMotionCruiseVelocity(m_handle,
+			sensorUnitsPer100ms, timeoutMs));
 }
 /**
  * Sets the Motion Magic Acceleration.  This is the target acceleration
@@ -1182,8 +1242,8 @@ ErrorCode BaseMotorController::ConfigMotionCruiseVelocity(
  */
 ErrorCode BaseMotorController::ConfigMotionAcceleration(
 		int sensorUnitsPer100msPerSec, int timeoutMs) {
-	return c_MotController_ConfigMotionAcceleration(m_handle,
-			sensorUnitsPer100msPerSec, timeoutMs);
+	return ErrorCounters::Count(m_handle, c_MotController_ConfigMotionAcceleration(m_handle,
+			sensorUnitsPer100msPerSec, timeoutMs));
 }
 
 //------ Motion Profile Buffer ----------//
@@ -1192,7 +1252,7 @@ ErrorCode BaseMotorController::ConfigMotionAcceleration(
  * (top).
  */
 void BaseMotorController::ClearMotionProfileTrajectories() {
-	c_MotController_ClearMotionProfileTrajectories(m_handle);
+	ErrorCounters::Count(m_handle, c_MotController_ClearMotionProfileTrajectories(m_handle));
 }
 /**
  * Retrieve just the buffer count for the api-level (top) buffer.
@@ -1203,7 +1263,8 @@ void BaseMotorController::ClearMotionProfileTrajectories() {
  */
 int BaseMotorController::GetMotionProfileTopLevelBufferCount() {
 	int param = 0;
-	c_MotController_GetMotionProfileTopLevelBufferCount(m_handle, &param);
+	ErrorCounters::Count(m_handle,
+			c_MotController_GetMotionProfileTopLevelBufferCount(m_handle, &param));
 	return param;
 }
 /**
@@ -1235,11 +1296,74 @@ int BaseMotorController::GetMotionProfileTopLevelBufferCount() {
  */
 ErrorCode BaseMotorController::PushMotionProfileTrajectory(
 		const ctre::phoenix::motion::TrajectoryPoint & trajPt) {
-	ErrorCode retval = c_MotController_PushMotionProfileTrajectory(m_handle,
+	ErrorCode retval = ErrorCounters::Count(m_handle,
+			c_MotController_PushMotionProfileTrajectory(m_handle,
 			trajPt.position, trajPt.velocity, trajPt.headingDeg,
-			trajPt.profileSlotSelect, trajPt.isLastPoint, trajPt.zeroPos);
+			trajPt.profileSlotSelect, trajPt.isLastPoint, trajPt.zeroPos));
 	return retval;
 }
+/**
+ * Push an already quantized trajectory point into the top level buffer.
+ * Position and velocity are integral and heading is fixed-point, so no
+ * further rounding happens on the way to the controller.
+ * @param trajPt to push into buffer.
+ * @return CTR_OKAY if trajectory point push ok. ErrorCode if buffer is
+ *         full due to kMotionProfileTopBufferCapacity.
+ */
+ErrorCode BaseMotorController::PushMotionProfileTrajectory(
+		const ctre::phoenix::motion::CompactTrajectoryPoint & trajPt) {
+	ErrorCode retval = ErrorCounters::Count(m_handle,
+			c_MotController_PushMotionProfileTrajectory(m_handle,
+			trajPt.position, trajPt.velocity, trajPt.GetHeadingDeg(),
+			trajPt.profileSlotSelect, trajPt.isLastPoint, trajPt.zeroPos));
+	return retval;
+}
+/**
+ * Move points from an application-side compact buffer into the top level
+ * buffer, keeping the top level buffer shallow.  This allows long profiles
+ * to be held at 12 bytes per point while the API only buffers a few
+ * points ahead of the controller.
+ * @param source compact buffer to pop points from.
+ * @param maxTopBufferCnt stop once the top level buffer holds this many points.
+ * @return number of points moved.
+ */
+int BaseMotorController::PushMotionProfileTrajectories(
+		ctre::phoenix::motion::CompactTrajectoryBuffer & source,
+		int maxTopBufferCnt) {
+	int moved = 0;
+	const ctre::phoenix::motion::CompactTrajectoryPoint * pts;
+	int run;
+	/* at most two runs, the second one starting where the ring wraps */
+	while ((run = source.Peek(pts)) > 0) {
+		int n = PushMotionProfileTrajectories(pts, run, maxTopBufferCnt);
+		source.Pop(n);
+		moved += n;
+		if (n < run)
+			break;
+	}
+	return moved;
+}
+/**
+ * Move points from an array of prepared points into the top level buffer,
+ * keeping the top level buffer shallow.
+ * @param points first point to send.
+ * @param count number of points available.
+ * @param maxTopBufferCnt stop once the top level buffer holds this many points.
+ * @return number of points moved, caller resumes from points + return value.
+ */
+int BaseMotorController::PushMotionProfileTrajectories(
+		const ctre::phoenix::motion::CompactTrajectoryPoint * points,
+		int count, int maxTopBufferCnt) {
+	int moved = 0;
+	int topCnt = GetMotionProfileTopLevelBufferCount();
+	while (topCnt < maxTopBufferCnt && moved < count) {
+		if (PushMotionProfileTrajectory(points[moved]) != OKAY)
+			break;
+		++topCnt;
+		++moved;
+	}
+	return moved;
+}
 /**
  * Retrieve just the buffer full for the api-level (top) buffer.
  * This routine performs no CAN or data structure lookups, so its fast and ideal
@@ -1248,7 +1372,8 @@ ErrorCode BaseMotorController::PushMotionProfileTrajectory(
  */
 bool BaseMotorController::IsMotionProfileTopLevelBufferFull() {
 	bool retval = false;
-	c_MotController_IsMotionProfileTopLevelBufferFull(m_handle, &retval);
+	ErrorCounters::Count(m_handle,
+			c_MotController_IsMotionProfileTopLevelBufferFull(m_handle, &retval));
 	return retval;
 }
 /**
@@ -1260,7 +1385,7 @@ bool BaseMotorController::IsMotionProfileTopLevelBufferFull() {
  * a mutex, so there is no harm in having the caller utilize threading.
  */
 void BaseMotorController::ProcessMotionProfileBuffer() {
-	c_MotController_ProcessMotionProfileBuffer(m_handle);
+	ErrorCounters::Count(m_handle, c_MotController_ProcessMotionProfileBuffer(m_handle));
 }
 /**
  * Retrieve all status information.
@@ -1309,12 +1434,13 @@ ErrorCode BaseMotorController::GetMotionProfileStatus(
 		ctre::phoenix::motion::MotionProfileStatus & statusToFill) {
 
 	int outputEnable = 0;
-	ErrorCode retval = c_MotController_GetMotionProfileStatus(m_handle,
+	ErrorCode retval = ErrorCounters::Count(m_handle,
+			c_MotController_GetMotionProfileStatus(m_handle,
 			&statusToFill.topBufferRem, &statusToFill.topBufferCnt,
 			&statusToFill.btmBufferCnt, &statusToFill.hasUnderrun,
 			&statusToFill.isUnderrun, &statusToFill.activePointValid,
 			&statusToFill.isLast, &statusToFill.profileSlotSelect,
-			&outputEnable);
+			&outputEnable));
 
 	statusToFill.outputEnable =
 			(ctre::phoenix::motion::SetValueMotionProfile) outputEnable;
@@ -1331,7 +1457,8 @@ ErrorCode BaseMotorController::GetMotionProfileStatus(
  * @return Error Code generated by function. 0 indicates no error.
  */
 ErrorCode BaseMotorController::ClearMotionProfileHasUnderrun(int timeoutMs) {
-	return c_MotController_ClearMotionProfileHasUnderrun(m_handle, timeoutMs);
+	return ErrorCounters::Count(m_handle,
+			c_MotController_ClearMotionProfileHasUnderrun(m_handle, timeoutMs));
 }
 /**
  * Calling application can opt to speed up the handshaking between the robot API
@@ -1342,7 +1469,8 @@ ErrorCode BaseMotorController::ClearMotionProfileHasUnderrun(int timeoutMs) {
  * @return Error Code generated by function. 0 indicates no error.
  */
 ErrorCode BaseMotorController::ChangeMotionControlFramePeriod(int periodMs) {
-	return c_MotController_ChangeMotionControlFramePeriod(m_handle, periodMs);
+	return ErrorCounters::Count(m_handle,
+			c_MotController_ChangeMotionControlFramePeriod(m_handle, periodMs));
 }
 
 //------ error ----------//
@@ -1365,7 +1493,8 @@ ErrorCode BaseMotorController::GetLastError() {
  */
 ErrorCode BaseMotorController::GetFaults(Faults & toFill) {
 	int faultBits;
-	ErrorCode retval = c_MotController_GetFaults(m_handle, &faultBits);
+	ErrorCode retval = ErrorCounters::Count(m_handle,
+			c_MotController_GetFaults(m_handle, &faultBits));
 	toFill = Faults(faultBits);
 	return retval;
 }
@@ -1376,7 +1505,8 @@ ErrorCode BaseMotorController::GetFaults(Faults & toFill) {
  */
 ErrorCode BaseMotorController::GetStickyFaults(StickyFaults & toFill) {
 	int faultBits;
-	ErrorCode retval = c_MotController_GetStickyFaults(m_handle, &faultBits);
+	ErrorCode retval = ErrorCounters::Count(m_handle,
+			c_MotController_GetStickyFaults(m_handle, &faultBits));
 	toFill = StickyFaults(faultBits);
 	return retval;
 }
@@ -1389,7 +1519,7 @@ ErrorCode BaseMotorController::GetStickyFaults(StickyFaults & toFill) {
  * @return Last Error Code generated by a function.
  */
 ErrorCode BaseMotorController::ClearStickyFaults(int timeoutMs) {
-	return c_MotController_ClearStickyFaults(m_handle, timeoutMs);
+	return ErrorCounters::Count(m_handle, c_MotController_ClearStickyFaults(m_handle, timeoutMs));
 }
 
 //------ Firmware ----------//
@@ -1400,7 +1530,7 @@ ErrorCode BaseMotorController::ClearStickyFaults(int timeoutMs) {
  */
 int BaseMotorController::GetFirmwareVersion() {
 	int retval = -1;
-	c_MotController_GetFirmwareVersion(m_handle, &retval);
+	ErrorCounters::Count(m_handle, c_MotController_GetFirmwareVersion(m_handle, &retval));
 	return retval;
 }
 /**
@@ -1410,7 +1540,7 @@ int BaseMotorController::GetFirmwareVersion() {
  */
 bool BaseMotorController::HasResetOccurred() {
 	bool retval = false;
-	c_MotController_HasResetOccurred(m_handle, &retval);
+	ErrorCounters::Count(m_handle, c_MotController_HasResetOccurred(m_handle, &retval));
 	return retval;
 }
 
@@ -1434,8 +1564,9 @@ bool BaseMotorController::HasResetOccurred() {
  */
 ErrorCode BaseMotorController::ConfigSetCustomParam(int newValue,
 		int paramIndex, int timeoutMs) {
-	return c_MotController_ConfigSetCustomParam(m_handle, newValue, paramIndex,
-			timeoutMs);
+	return ErrorCounters::Count(m_handle,
+			c_MotController_ConfigSetCustomParam(m_handle, newValue, paramIndex,
+			timeoutMs));
 }
 
 /**
@@ -1451,8 +1582,9 @@ ErrorCode BaseMotorController::ConfigSetCustomParam(int newValue,
  */
 int BaseMotorController::ConfigGetCustomParam(int paramIndex, int timeoutMs) {
 	int readValue;
-	c_MotController_ConfigGetCustomParam(m_handle, &readValue, paramIndex,
-			timeoutMs);
+	ErrorCounters::Count(m_handle,
+			c_MotController_ConfigGetCustomParam(m_handle, &readValue, paramIndex,
+			timeoutMs));
 	return readValue;
 }
 
@@ -1480,8 +1612,9 @@ int BaseMotorController::ConfigGetCustomParam(int paramIndex, int timeoutMs) {
  */
 ErrorCode BaseMotorController::ConfigSetParameter(ParamEnum param, double value,
 		uint8_t subValue, int ordinal, int timeoutMs) {
-	return c_MotController_ConfigSetParameter(m_handle, param, value, subValue,
-			ordinal, timeoutMs);
+	return ErrorCounters::Count(m_handle,
+			c_MotController_ConfigSetParameter(m_handle, param, value, subValue,
+			ordinal, timeoutMs));
 }
 
 /**
@@ -1500,8 +1633,9 @@ ErrorCode BaseMotorController::ConfigSetParameter(ParamEnum param, double value,
 double BaseMotorController::ConfigGetParameter(ParamEnum param, int ordinal,
 		int timeoutMs) {
 	double value = 0;
-	c_MotController_ConfigGetParameter(m_handle, param, &value, ordinal,
-			timeoutMs);
+	ErrorCounters::Count(m_handle,
+			c_MotController_ConfigGetParameter(m_handle, param, &value, ordinal,
+			timeoutMs));
 	return (double) value;
 }
 
@@ -1,5 +1,6 @@
 #include "ctre/phoenix/MotorControl/CAN/TalonSRX.h"
 #include "ctre/phoenix/CCI/MotController_CCI.h"
+#include "ctre/phoenix/ErrorCounters.h"
 #include "HAL/HAL.h"
 
 using namespace ctre::phoenix;
@@ -290,7 +291,8 @@ ctre::phoenix::ErrorCode TalonSRX::ConfigReverseLimitSwitchSource(
  *            If zero, no blocking or checking is performed.
  */
 ctre::phoenix::ErrorCode TalonSRX::ConfigPeakCurrentLimit(int amps, int timeoutMs) {
-	return c_MotController_ConfigPeakCurrentLimit(m_handle, amps, timeoutMs);
+	return ErrorCounters::Count(m_handle,
+			c_MotController_ConfigPeakCurrentLimit(m_handle, amps, timeoutMs));
 }
 /**
  * Configure the peak allowable duration (when current limit is enabled).
@@ -309,8 +311,9 @@ ctre::phoenix::ErrorCode TalonSRX::ConfigPeakCurrentLimit(int amps, int timeoutM
  *            If zero, no blocking or checking is performed.
  */
 ctre::phoenix::ErrorCode TalonSRX::ConfigPeakCurrentDuration(int milliseconds, int timeoutMs) {
-	return c_MotController_ConfigPeakCurrentDuration(m_handle, milliseconds,
-			timeoutMs);
+	return ErrorCounters::Count(m_handle,
+			c_MotController_ConfigPeakCurrentDuration(m_handle, milliseconds,
+			timeoutMs));
 }
 /**
  * Configure the continuous allowable current-draw (when current limit is enabled).
@@ -329,7 +332,8 @@ ctre::phoenix::ErrorCode TalonSRX::ConfigPeakCurrentDuration(int milliseconds, i
  *            If zero, no blocking or checking is performed.
  */
 ctre::phoenix::ErrorCode TalonSRX::ConfigContinuousCurrentLimit(int amps, int timeoutMs) {
-	return c_MotController_ConfigContinuousCurrentLimit(m_handle, amps, timeoutMs);
+	return ErrorCounters::Count(m_handle,
+			c_MotController_ConfigContinuousCurrentLimit(m_handle, amps, timeoutMs));
 }
 /**
  * Enable or disable Current Limit.
@@ -338,6 +342,6 @@ ctre::phoenix::ErrorCode TalonSRX::ConfigContinuousCurrentLimit(int amps, int ti
  * @see ConfigPeakCurrentLimit, ConfigPeakCurrentDuration, ConfigContinuousCurrentLimit
  */
 void TalonSRX::EnableCurrentLimit(bool enable) {
-	c_MotController_EnableCurrentLimit(m_handle, enable);
+	ErrorCounters::Count(m_handle, c_MotController_EnableCurrentLimit(m_handle, enable));
 }
 
@@ -1,5 +1,6 @@
 #include "ctre/phoenix/MotorControl/SensorCollection.h"
 #include "ctre/phoenix/CCI/MotController_CCI.h"
+#include "ctre/phoenix/ErrorCounters.h"
 
 using namespace ctre::phoenix;
 using namespace ctre::phoenix::motorcontrol;
@@ -19,7 +20,7 @@ SensorCollection::SensorCollection(void * handle) {
 
 int SensorCollection::GetAnalogIn() {
 	int retval = 0;
-	c_MotController_GetAnalogIn(_handle, &retval);
+	ErrorCounters::Count(_handle, c_MotController_GetAnalogIn(_handle, &retval));
 	return retval;
 }
 
@@ -36,7 +37,8 @@ int SensorCollection::GetAnalogIn() {
  */
 
 ErrorCode SensorCollection::SetAnalogPosition(int newPosition, int timeoutMs) {
-	return c_MotController_SetAnalogPosition(_handle, newPosition, timeoutMs);
+	return ErrorCounters::Count(_handle,
+			c_MotController_SetAnalogPosition(_handle, newPosition, timeoutMs));
 }
 
 /**
@@ -48,7 +50,7 @@ ErrorCode SensorCollection::SetAnalogPosition(int newPosition, int timeoutMs) {
 
 int SensorCollection::GetAnalogInRaw() {
 	int retval = 0;
-	c_MotController_GetAnalogInRaw(_handle, &retval);
+	ErrorCounters::Count(_handle, c_MotController_GetAnalogInRaw(_handle, &retval));
 	return retval;
 }
 
@@ -61,7 +63,7 @@ int SensorCollection::GetAnalogInRaw() {
 
 int SensorCollection::GetAnalogInVel() {
 	int retval = 0;
-	c_MotController_GetAnalogInVel(_handle, &retval);
+	ErrorCounters::Count(_handle, c_MotController_GetAnalogInVel(_handle, &retval));
 	return retval;
 }
 
@@ -74,7 +76,7 @@ int SensorCollection::GetAnalogInVel() {
 
 int SensorCollection::GetQuadraturePosition() {
 	int retval = 0;
-	c_MotController_GetQuadraturePosition(_handle, &retval);
+	ErrorCounters::Count(_handle, c_MotController_GetQuadraturePosition(_handle, &retval));
 	return retval;
 }
 
@@ -94,8 +96,8 @@ int SensorCollection::GetQuadraturePosition() {
 
 ErrorCode SensorCollection::SetQuadraturePosition(int newPosition,
 		int timeoutMs) {
-	return c_MotController_SetQuadraturePosition(_handle, newPosition,
-			timeoutMs);
+	return ErrorCounters::Count(_handle, c_MotController_SetQuadraturePosition(_handle, newPosition,
+			timeoutMs));
 }
 
 /**
@@ -107,7 +109,7 @@ ErrorCode SensorCollection::SetQuadraturePosition(int newPosition,
 
 int SensorCollection::GetQuadratureVelocity() {
 	int retval = 0;
-	c_MotController_GetQuadratureVelocity(_handle, &retval);
+	ErrorCounters::Count(_handle, c_MotController_GetQuadratureVelocity(_handle, &retval));
 	return retval;
 }
 
@@ -120,7 +122,7 @@ int SensorCollection::GetQuadratureVelocity() {
 
 int SensorCollection::GetPulseWidthPosition() {
 	int retval = 0;
-	c_MotController_GetPulseWidthPosition(_handle, &retval);
+	ErrorCounters::Count(_handle, c_MotController_GetPulseWidthPosition(_handle, &retval));
 	return retval;
 }
 
@@ -137,8 +139,8 @@ int SensorCollection::GetPulseWidthPosition() {
  */
 ErrorCode SensorCollection::SetPulseWidthPosition(int newPosition,
 		int timeoutMs) {
-	return c_MotController_SetPulseWidthPosition(_handle, newPosition,
-			timeoutMs);
+	return ErrorCounters::Count(_handle, c_MotController_SetPulseWidthPosition(_handle, newPosition,
+			timeoutMs));
 }
 
 /**
@@ -150,7 +152,7 @@ ErrorCode SensorCollection::SetPulseWidthPosition(int newPosition,
 
 int SensorCollection::GetPulseWidthVelocity() {
 	int retval = 0;
-	c_MotController_GetPulseWidthVelocity(_handle, &retval);
+	ErrorCounters::Count(_handle, c_MotController_GetPulseWidthVelocity(_handle, &retval));
 	return retval;
 }
 
@@ -162,7 +164,7 @@ int SensorCollection::GetPulseWidthVelocity() {
 
 int SensorCollection::GetPulseWidthRiseToFallUs() {
 	int retval = 0;
-	c_MotController_GetPulseWidthRiseToFallUs(_handle, &retval);
+	ErrorCounters::Count(_handle, c_MotController_GetPulseWidthRiseToFallUs(_handle, &retval));
 	return retval;
 }
 
@@ -174,7 +176,7 @@ int SensorCollection::GetPulseWidthRiseToFallUs() {
 
 int SensorCollection::GetPulseWidthRiseToRiseUs() {
 	int retval = 0;
-	c_MotController_GetPulseWidthRiseToRiseUs(_handle, &retval);
+	ErrorCounters::Count(_handle, c_MotController_GetPulseWidthRiseToRiseUs(_handle, &retval));
 	return retval;
 }
 
@@ -186,7 +188,7 @@ int SensorCollection::GetPulseWidthRiseToRiseUs() {
 
 int SensorCollection::GetPinStateQuadA() {
 	int retval = 0;
-	c_MotController_GetPinStateQuadA(_handle, &retval);
+	ErrorCounters::Count(_handle, c_MotController_GetPinStateQuadA(_handle, &retval));
 	return retval;
 }
 
@@ -198,7 +200,7 @@ int SensorCollection::GetPinStateQuadA() {
 
 int SensorCollection::GetPinStateQuadB() {
 	int retval = 0;
-	c_MotController_GetPinStateQuadB(_handle, &retval);
+	ErrorCounters::Count(_handle, c_MotController_GetPinStateQuadB(_handle, &retval));
 	return retval;
 }
 
@@ -210,7 +212,7 @@ int SensorCollection::GetPinStateQuadB() {
 
 int SensorCollection::GetPinStateQuadIdx() {
 	int retval = 0;
-	c_MotController_GetPinStateQuadIdx(_handle, &retval);
+	ErrorCounters::Count(_handle, c_MotController_GetPinStateQuadIdx(_handle, &retval));
 	return retval;
 }
 
@@ -223,7 +225,7 @@ int SensorCollection::GetPinStateQuadIdx() {
 
 int SensorCollection::IsFwdLimitSwitchClosed() {
 	int retval = 0;
-	c_MotController_IsFwdLimitSwitchClosed(_handle, &retval);
+	ErrorCounters::Count(_handle, c_MotController_IsFwdLimitSwitchClosed(_handle, &retval));
 	return retval;
 }
 
@@ -236,6 +238,6 @@ int SensorCollection::IsFwdLimitSwitchClosed() {
 
 int SensorCollection::IsRevLimitSwitchClosed() {
 	int retval = 0;
-	c_MotController_IsRevLimitSwitchClosed(_handle, &retval);
+	ErrorCounters::Count(_handle, c_MotController_IsRevLimitSwitchClosed(_handle, &retval));
 	return retval;
 }
@@ -1,12 +1,15 @@
 #ifndef CTR_EXCLUDE_WPILIB_CLASSES
 
 #include "ctre/phoenix/RCRadio3Ch.h"
-#include <vector>
 
 namespace ctre {
 namespace phoenix {
 
-RCRadio3Ch::RCRadio3Ch(ctre::phoenix::CANifier *canifier) {
+static const double kPulseUs[] = { 1000, 2000 };
+static const double kPerc[] = { -1, 1 };
+
+RCRadio3Ch::RCRadio3Ch(ctre::phoenix::CANifier *canifier) :
+		_pulseToPerc(kPulseUs, kPerc, InterpolationTable::Clamp) {
 	_canifier = canifier;
 }
 
@@ -15,20 +18,7 @@ float RCRadio3Ch::GetDutyCycleUs(Channel channel) {
 }
 
 float RCRadio3Ch::GetDutyCyclePerc(Channel channel) {
-	float retval = RCRadio3Ch::GetDutyCycleUs(channel);
-
-	std::vector<double> xData = { 1000, 2000 };
-	std::vector<double> yData = { -1, 1 };
-
-	retval = RCRadio3Ch::Interpolate(xData, yData, retval, true);
-
-	if (retval < -1) {
-		retval = -1;
-	} else if (retval > +1) {
-		retval = +1;
-	}
-
-	return retval;
+	return (float) _pulseToPerc.Lookup(RCRadio3Ch::GetDutyCycleUs(channel));
 }
 
 bool RCRadio3Ch::GetSwitchValue(Channel channel) {
@@ -82,32 +72,6 @@ void RCRadio3Ch::Process() {
 	CurrentStatus = health;	//Will have to change this to a getter and a setter
 }
 
-double RCRadio3Ch::Interpolate(std::vector<double> &xData,
-		std::vector<double> &yData, double x, bool extrapolate) {
-	int size = xData.size();
-
-	int i = 0;                    // find left end of interval for interpolation
-	if (x >= xData[size - 2])                  // special case: beyond right end
-			{
-		i = size - 2;
-	} else {
-		while (x > xData[i + 1])
-			i++;
-	}
-	double xL = xData[i], yL = yData[i], xR = xData[i + 1], yR = yData[i + 1]; // points on either side (unless beyond ends)
-	if (!extrapolate)           // if beyond ends of array and not extrapolating
-	{
-		if (x < xL)
-			yR = yL;
-		if (x > xR)
-			yL = yR;
-	}
-
-	double dydx = (yR - yL) / (xR - xL);                             // gradient
-
-	return yL + dydx * (x - xL);
-}
-
 }
 }
 #endif
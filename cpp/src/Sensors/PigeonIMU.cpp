@@ -26,6 +26,7 @@
 #ifndef CTR_EXCLUDE_WPILIB_CLASSES
 #include "ctre/phoenix/Sensors/PigeonIMU.h"
 #include "ctre/phoenix/CTRLogger.h"
+#include "ctre/phoenix/ErrorCounters.h"
 #include "ctre/phoenix/CCI/Logger_CCI.h"
 #include "ctre/phoenix/CCI/PigeonIMU_CCI.h"
 #include "ctre/phoenix/MotorControl/CAN/TalonSRX.h"
@@ -49,6 +50,7 @@ PigeonIMU::PigeonIMU(int deviceNumber) :
 		CANBusAddressable(deviceNumber) {
 	_handle = c_PigeonIMU_Create1(deviceNumber);
 	_deviceNumber = deviceNumber;
+	ErrorCounters::Register(_handle, ErrorCounters::PigeonIMU, _deviceNumber);
 	HAL_Report(HALUsageReporting::kResourceType_PigeonIMU, _deviceNumber + 1);
 }
 
@@ -60,6 +62,7 @@ PigeonIMU::PigeonIMU(ctre::phoenix::motorcontrol::can::TalonSRX * talonSrx) :
 		CANBusAddressable(0) {
 	_handle = c_PigeonIMU_Create2(talonSrx->GetDeviceID());
 	_deviceNumber = talonSrx->GetDeviceID();
+	ErrorCounters::Register(_handle, ErrorCounters::PigeonIMU, _deviceNumber);
 	HAL_Report(HALUsageReporting::kResourceType_PigeonIMU, _deviceNumber + 1);
 	HAL_Report(HALUsageReporting::kResourceType_CTRE_future0, _deviceNumber + 1); //record as Pigeon-via-Uart
 }
@@ -75,7 +78,7 @@ PigeonIMU::PigeonIMU(ctre::phoenix::motorcontrol::can::TalonSRX * talonSrx) :
  * @return Error Code generated by function. 0 indicates no error.
  */
 int PigeonIMU::SetYaw(double angleDeg, int timeoutMs) {
-	int errCode = c_PigeonIMU_SetYaw(_handle, angleDeg, timeoutMs);
+	int errCode = ErrorCounters::Count(_handle, c_PigeonIMU_SetYaw(_handle, angleDeg, timeoutMs));
 	return errCode;
 }
 /**
@@ -89,7 +92,7 @@ int PigeonIMU::SetYaw(double angleDeg, int timeoutMs) {
  * @return Error Code generated by function. 0 indicates no error.
  */
 int PigeonIMU::AddYaw(double angleDeg, int timeoutMs) {
-	int errCode = c_PigeonIMU_AddYaw(_handle, angleDeg, timeoutMs);
+	int errCode = ErrorCounters::Count(_handle, c_PigeonIMU_AddYaw(_handle, angleDeg, timeoutMs));
 	return errCode;
 }
 /**
@@ -102,7 +105,7 @@ int PigeonIMU::AddYaw(double angleDeg, int timeoutMs) {
  * @return Error Code generated by function. 0 indicates no error.
  */
 int PigeonIMU::SetYawToCompass(int timeoutMs) {
-	int errCode = c_PigeonIMU_SetYawToCompass(_handle, timeoutMs);
+	int errCode = ErrorCounters::Count(_handle, c_PigeonIMU_SetYawToCompass(_handle, timeoutMs));
 	return errCode;
 }
 /**
@@ -116,7 +119,8 @@ int PigeonIMU::SetYawToCompass(int timeoutMs) {
  * @return Error Code generated by function. 0 indicates no error.
  */
 int PigeonIMU::SetFusedHeading(double angleDeg, int timeoutMs) {
-	int errCode = c_PigeonIMU_SetFusedHeading(_handle, angleDeg, timeoutMs);
+	int errCode = ErrorCounters::Count(_handle,
+			c_PigeonIMU_SetFusedHeading(_handle, angleDeg, timeoutMs));
 	return errCode;
 }
 /**
@@ -130,7 +134,8 @@ int PigeonIMU::SetFusedHeading(double angleDeg, int timeoutMs) {
  * @return Error Code generated by function. 0 indicates no error.
  */
 int PigeonIMU::SetAccumZAngle(double angleDeg, int timeoutMs) {
-	int errCode = c_PigeonIMU_SetAccumZAngle(_handle, angleDeg, timeoutMs);
+	int errCode = ErrorCounters::Count(_handle,
+			c_PigeonIMU_SetAccumZAngle(_handle, angleDeg, timeoutMs));
 	return errCode;
 }
 /**
@@ -145,8 +150,9 @@ int PigeonIMU::SetAccumZAngle(double angleDeg, int timeoutMs) {
  */
 int PigeonIMU::ConfigTemperatureCompensationEnable(bool bTempCompEnable,
 		int timeoutMs) {
-	int errCode = c_PigeonIMU_ConfigTemperatureCompensationEnable(_handle,
-			bTempCompEnable, timeoutMs);
+	int errCode = ErrorCounters::Count(_handle,
+			c_PigeonIMU_ConfigTemperatureCompensationEnable(_handle,
+			bTempCompEnable, timeoutMs));
 	return errCode;
 }
 /**
@@ -160,7 +166,8 @@ int PigeonIMU::ConfigTemperatureCompensationEnable(bool bTempCompEnable,
  * @return Error Code generated by function. 0 indicates no error.
  */
 int PigeonIMU::AddFusedHeading(double angleDeg, int timeoutMs) {
-	int errCode = c_PigeonIMU_AddFusedHeading(_handle, angleDeg, timeoutMs);
+	int errCode = ErrorCounters::Count(_handle,
+			c_PigeonIMU_AddFusedHeading(_handle, angleDeg, timeoutMs));
 	return errCode;
 }
 /**
@@ -173,7 +180,8 @@ int PigeonIMU::AddFusedHeading(double angleDeg, int timeoutMs) {
  * @return Error Code generated by function. 0 indicates no error.
  */
 int PigeonIMU::SetFusedHeadingToCompass(int timeoutMs) {
-	int errCode = c_PigeonIMU_SetFusedHeadingToCompass(_handle, timeoutMs);
+	int errCode = ErrorCounters::Count(_handle,
+			c_PigeonIMU_SetFusedHeadingToCompass(_handle, timeoutMs));
 	return errCode;
 }
 /**
@@ -188,8 +196,9 @@ int PigeonIMU::SetFusedHeadingToCompass(int timeoutMs) {
  * @return Error Code generated by function. 0 indicates no error.
  */
 int PigeonIMU::SetCompassDeclination(double angleDegOffset, int timeoutMs) {
-	int errCode = c_PigeonIMU_SetCompassDeclination(_handle, angleDegOffset,
-			timeoutMs);
+	int errCode = ErrorCounters::Count(_handle,
+			c_PigeonIMU_SetCompassDeclination(_handle, angleDegOffset,
+			timeoutMs));
 	return errCode;
 }
 /**
@@ -204,7 +213,8 @@ int PigeonIMU::SetCompassDeclination(double angleDegOffset, int timeoutMs) {
  * @return Error Code generated by function. 0 indicates no error.
  */
 int PigeonIMU::SetCompassAngle(double angleDeg, int timeoutMs) {
-	int errCode = c_PigeonIMU_SetCompassAngle(_handle, angleDeg, timeoutMs);
+	int errCode = ErrorCounters::Count(_handle,
+			c_PigeonIMU_SetCompassAngle(_handle, angleDeg, timeoutMs));
 	return errCode;
 }
 //----------------------- Calibration routines -----------------------//
@@ -220,7 +230,8 @@ int PigeonIMU::SetCompassAngle(double angleDeg, int timeoutMs) {
  * @return Error Code generated by function. 0 indicates no error.
  */
 int PigeonIMU::EnterCalibrationMode(CalibrationMode calMode, int timeoutMs) {
-	return c_PigeonIMU_EnterCalibrationMode(_handle, calMode, timeoutMs);
+	return ErrorCounters::Count(_handle,
+			c_PigeonIMU_EnterCalibrationMode(_handle, calMode, timeoutMs));
 }
 /**
  * Get the status of the current (or previousley complete) calibration.
@@ -239,9 +250,10 @@ int PigeonIMU::GetGeneralStatus(PigeonIMU::GeneralStatus & statusToFill) {
 	int tempCompensationCount;
 	int lastError;
 
-	int errCode = c_PigeonIMU_GetGeneralStatus(_handle, &state, &currentMode,
+	int errCode = ErrorCounters::Count(_handle,
+			c_PigeonIMU_GetGeneralStatus(_handle, &state, &currentMode,
 			&calibrationError, &bCalIsBooting, &tempC, &upTimeSec,
-			&noMotionBiasCount, &tempCompensationCount, &lastError);
+			&noMotionBiasCount, &tempCompensationCount, &lastError));
 
 	statusToFill.currentMode = (PigeonIMU::CalibrationMode) currentMode;
 	statusToFill.calibrationError = calibrationError;
@@ -324,7 +336,7 @@ int PigeonIMU::GetLastError() {
  * @return The last ErrorCode generated.
  */
 int PigeonIMU::Get6dQuaternion(double wxyz[4]) {
-	int errCode = c_PigeonIMU_Get6dQuaternion(_handle, wxyz);
+	int errCode = ErrorCounters::Count(_handle, c_PigeonIMU_Get6dQuaternion(_handle, wxyz));
 	return errCode;
 }
 /**
@@ -334,7 +346,7 @@ int PigeonIMU::Get6dQuaternion(double wxyz[4]) {
  * @return The last ErrorCode generated.
  */
 int PigeonIMU::GetYawPitchRoll(double ypr[3]) {
-	int errCode = c_PigeonIMU_GetYawPitchRoll(_handle, ypr);
+	int errCode = ErrorCounters::Count(_handle, c_PigeonIMU_GetYawPitchRoll(_handle, ypr));
 	return errCode;
 }
 /**
@@ -345,7 +357,7 @@ int PigeonIMU::GetYawPitchRoll(double ypr[3]) {
  * @return The last ErrorCode generated.
  */
 int PigeonIMU::GetAccumGyro(double xyz_deg[3]) {
-	int errCode = c_PigeonIMU_GetAccumGyro(_handle, xyz_deg);
+	int errCode = ErrorCounters::Count(_handle, c_PigeonIMU_GetAccumGyro(_handle, xyz_deg));
 	return errCode;
 }
 /**
@@ -354,7 +366,7 @@ int PigeonIMU::GetAccumGyro(double xyz_deg[3]) {
  */
 double PigeonIMU::GetAbsoluteCompassHeading() {
 	double retval;
-	c_PigeonIMU_GetAbsoluteCompassHeading(_handle, &retval);
+	ErrorCounters::Count(_handle, c_PigeonIMU_GetAbsoluteCompassHeading(_handle, &retval));
 	return retval;
 }
 /**
@@ -364,7 +376,7 @@ double PigeonIMU::GetAbsoluteCompassHeading() {
  */
 double PigeonIMU::GetCompassHeading() {
 	double retval;
-	c_PigeonIMU_GetCompassHeading(_handle, &retval);
+	ErrorCounters::Count(_handle, c_PigeonIMU_GetCompassHeading(_handle, &retval));
 	return retval;
 }
 /**
@@ -373,7 +385,7 @@ double PigeonIMU::GetCompassHeading() {
  */
 double PigeonIMU::GetCompassFieldStrength() {
 	double retval;
-	c_PigeonIMU_GetCompassFieldStrength(_handle, &retval);
+	ErrorCounters::Count(_handle, c_PigeonIMU_GetCompassFieldStrength(_handle, &retval));
 	return retval;
 }
 /**
@@ -383,7 +395,7 @@ double PigeonIMU::GetCompassFieldStrength() {
  */
 double PigeonIMU::GetTemp() {
 	double tempC;
-	c_PigeonIMU_GetTemp(_handle, &tempC);
+	ErrorCounters::Count(_handle, c_PigeonIMU_GetTemp(_handle, &tempC));
 	return tempC;
 }
 /**
@@ -393,7 +405,7 @@ double PigeonIMU::GetTemp() {
  */
 PigeonIMU::PigeonState PigeonIMU::GetState() {
 	int retval;
-	c_PigeonIMU_GetState(_handle, &retval);
+	ErrorCounters::Count(_handle, c_PigeonIMU_GetState(_handle, &retval));
 	return (PigeonIMU::PigeonState) retval;
 }
 /**
@@ -404,7 +416,7 @@ PigeonIMU::PigeonState PigeonIMU::GetState() {
  */
 uint32_t PigeonIMU::GetUpTime() {
 	int timeSec;
-	c_PigeonIMU_GetUpTime(_handle, &timeSec);
+	ErrorCounters::Count(_handle, c_PigeonIMU_GetUpTime(_handle, &timeSec));
 	return timeSec;
 }
 /**
@@ -414,7 +426,7 @@ uint32_t PigeonIMU::GetUpTime() {
  * @return The last ErrorCode generated.
  */
 int PigeonIMU::GetRawMagnetometer(int16_t rm_xyz[3]) {
-	int errCode = c_PigeonIMU_GetRawMagnetometer(_handle, rm_xyz);
+	int errCode = ErrorCounters::Count(_handle, c_PigeonIMU_GetRawMagnetometer(_handle, rm_xyz));
 	return errCode;
 }
 /**
@@ -424,7 +436,7 @@ int PigeonIMU::GetRawMagnetometer(int16_t rm_xyz[3]) {
  * @return The last ErrorCode generated.
  */
 int PigeonIMU::GetBiasedMagnetometer(int16_t bm_xyz[3]) {
-	int errCode = c_PigeonIMU_GetBiasedMagnetometer(_handle, bm_xyz);
+	int errCode = ErrorCounters::Count(_handle, c_PigeonIMU_GetBiasedMagnetometer(_handle, bm_xyz));
 	return errCode;
 }
 /**
@@ -434,7 +446,8 @@ int PigeonIMU::GetBiasedMagnetometer(int16_t bm_xyz[3]) {
  * @return The last ErrorCode generated.
  */
 int PigeonIMU::GetBiasedAccelerometer(int16_t ba_xyz[3]) {
-	int errCode = c_PigeonIMU_GetBiasedAccelerometer(_handle, ba_xyz);
+	int errCode = ErrorCounters::Count(_handle,
+			c_PigeonIMU_GetBiasedAccelerometer(_handle, ba_xyz));
 	return errCode;
 }
 /**
@@ -444,7 +457,7 @@ int PigeonIMU::GetBiasedAccelerometer(int16_t ba_xyz[3]) {
  * @return The last ErrorCode generated.
  */
 int PigeonIMU::GetRawGyro(double xyz_dps[3]) {
-	int errCode = c_PigeonIMU_GetRawGyro(_handle, xyz_dps);
+	int errCode = ErrorCounters::Count(_handle, c_PigeonIMU_GetRawGyro(_handle, xyz_dps));
 	return errCode;
 }
 /**
@@ -454,7 +467,8 @@ int PigeonIMU::GetRawGyro(double xyz_dps[3]) {
  * @return The last ErrorCode generated.
  */
 int PigeonIMU::GetAccelerometerAngles(double tiltAngles[3]) {
-	int errCode = c_PigeonIMU_GetAccelerometerAngles(_handle, tiltAngles);
+	int errCode = ErrorCounters::Count(_handle,
+			c_PigeonIMU_GetAccelerometerAngles(_handle, tiltAngles));
 	return errCode;
 }
 /**
@@ -469,8 +483,9 @@ double PigeonIMU::GetFusedHeading(FusionStatus & status) {
 	double fusedHeading;
 	int lastError;
 
-	int errCode = c_PigeonIMU_GetFusedHeading2(_handle, &bIsFusing, &bIsValid,
-			&fusedHeading, &lastError);
+	int errCode = ErrorCounters::Count(_handle,
+			c_PigeonIMU_GetFusedHeading2(_handle, &bIsFusing, &bIsValid,
+			&fusedHeading, &lastError));
 
 	std::string description;
 
@@ -505,7 +520,7 @@ double PigeonIMU::GetFusedHeading(FusionStatus & status) {
  */
 double PigeonIMU::GetFusedHeading() {
 	double fusedHeading;
-	c_PigeonIMU_GetFusedHeading1(_handle, &fusedHeading);
+	ErrorCounters::Count(_handle, c_PigeonIMU_GetFusedHeading1(_handle, &fusedHeading));
 	return fusedHeading;
 }
 //----------------------- Startup/Reset status -----------------------//
@@ -514,12 +529,12 @@ double PigeonIMU::GetFusedHeading() {
  */
 uint32_t PigeonIMU::GetResetCount() {
 	int retval;
-	c_PigeonIMU_GetResetCount(_handle, &retval);
+	ErrorCounters::Count(_handle, c_PigeonIMU_GetResetCount(_handle, &retval));
 	return retval;
 }
 uint32_t PigeonIMU::GetResetFlags() {
 	int retval;
-	c_PigeonIMU_GetResetCount(_handle, &retval);
+	ErrorCounters::Count(_handle, c_PigeonIMU_GetResetCount(_handle, &retval));
 	return (uint32_t) retval;
 }
 /**
@@ -527,7 +542,7 @@ uint32_t PigeonIMU::GetResetFlags() {
  */
 uint32_t PigeonIMU::GetFirmVers() {
 	int retval;
-	c_PigeonIMU_GetFirmwareVersion(_handle, &retval);
+	ErrorCounters::Count(_handle, c_PigeonIMU_GetFirmwareVersion(_handle, &retval));
 	return retval;
 }
 /**
@@ -535,7 +550,7 @@ uint32_t PigeonIMU::GetFirmVers() {
  */
 bool PigeonIMU::HasResetOccurred() {
 	bool retval = false;
-	c_PigeonIMU_HasResetOccurred(_handle, &retval);
+	ErrorCounters::Count(_handle, c_PigeonIMU_HasResetOccurred(_handle, &retval));
 	return retval;
 }
 
@@ -597,8 +612,9 @@ std::string PigeonIMU::ToString(CalibrationMode cm) {
  */
 ErrorCode PigeonIMU::ConfigSetCustomParam(int newValue, int paramIndex,
 		int timeoutMs) {
-	return c_PigeonIMU_ConfigSetCustomParam(_handle, newValue, paramIndex,
-			timeoutMs);
+	return ErrorCounters::Count(_handle,
+			c_PigeonIMU_ConfigSetCustomParam(_handle, newValue, paramIndex,
+			timeoutMs));
 }
 /**
  * Gets the value of a custom parameter. This is for arbitrary use.
@@ -617,8 +633,8 @@ ErrorCode PigeonIMU::ConfigSetCustomParam(int newValue, int paramIndex,
  */
 int PigeonIMU::ConfigGetCustomParam(int paramIndex, int timeoutMs) {
 	int readValue;
-	c_PigeonIMU_ConfigGetCustomParam(_handle, &readValue, paramIndex,
-			timeoutMs);
+	ErrorCounters::Count(_handle, c_PigeonIMU_ConfigGetCustomParam(_handle, &readValue, paramIndex,
+			timeoutMs));
 	return readValue;
 }
 /**
@@ -644,8 +660,9 @@ int PigeonIMU::ConfigGetCustomParam(int paramIndex, int timeoutMs) {
  */
 ErrorCode PigeonIMU::ConfigSetParameter(ctre::phoenix::ParamEnum param, double value,
 		uint8_t subValue, int ordinal, int timeoutMs) {
-	return c_PigeonIMU_ConfigSetParameter(_handle, param, value, subValue,
-			ordinal, timeoutMs);
+	return ErrorCounters::Count(_handle,
+			c_PigeonIMU_ConfigSetParameter(_handle, param, value, subValue,
+			ordinal, timeoutMs));
 
 }
 /**
@@ -668,7 +685,8 @@ ErrorCode PigeonIMU::ConfigSetParameter(ctre::phoenix::ParamEnum param, double v
 double PigeonIMU::ConfigGetParameter(ctre::phoenix::ParamEnum param, int ordinal,
 		int timeoutMs) {
 	double value = 0;
-	c_PigeonIMU_ConfigGetParameter(_handle, param, &value, ordinal, timeoutMs);
+	ErrorCounters::Count(_handle,
+			c_PigeonIMU_ConfigGetParameter(_handle, param, &value, ordinal, timeoutMs));
 	return value;
 }
 
@@ -689,8 +707,9 @@ double PigeonIMU::ConfigGetParameter(ctre::phoenix::ParamEnum param, int ordinal
  */
 ErrorCode PigeonIMU::SetStatusFramePeriod(PigeonIMU_StatusFrame statusFrame,
 		int periodMs, int timeoutMs) {
-	return c_PigeonIMU_SetStatusFramePeriod(_handle, statusFrame, periodMs,
-			timeoutMs);
+	return ErrorCounters::Count(_handle,
+			c_PigeonIMU_SetStatusFramePeriod(_handle, statusFrame, periodMs,
+			timeoutMs));
 }
 /**
  * Gets the period of the given status frame.
@@ -706,7 +725,8 @@ ErrorCode PigeonIMU::SetStatusFramePeriod(PigeonIMU_StatusFrame statusFrame,
 int PigeonIMU::GetStatusFramePeriod(PigeonIMU_StatusFrame frame,
 		int timeoutMs) {
 	int periodMs = 0;
-	c_PigeonIMU_GetStatusFramePeriod(_handle, frame, &periodMs, timeoutMs);
+	ErrorCounters::Count(_handle,
+			c_PigeonIMU_GetStatusFramePeriod(_handle, frame, &periodMs, timeoutMs));
 	return periodMs;
 }
 /**
@@ -720,7 +740,8 @@ int PigeonIMU::GetStatusFramePeriod(PigeonIMU_StatusFrame frame,
  */
 ErrorCode PigeonIMU::SetControlFramePeriod(PigeonIMU_ControlFrame frame,
 		int periodMs) {
-	return c_PigeonIMU_SetControlFramePeriod(_handle, frame, periodMs);
+	return ErrorCounters::Count(_handle,
+			c_PigeonIMU_SetControlFramePeriod(_handle, frame, periodMs));
 }
 //------ Firmware ----------//
 /**
@@ -731,7 +752,7 @@ ErrorCode PigeonIMU::SetControlFramePeriod(PigeonIMU_ControlFrame frame,
  */
 int PigeonIMU::GetFirmwareVersion() {
 	int retval = -1;
-	c_PigeonIMU_GetFirmwareVersion(_handle, &retval);
+	ErrorCounters::Count(_handle, c_PigeonIMU_GetFirmwareVersion(_handle, &retval));
 	return retval;
 }
 //------ Faults ----------//
@@ -744,7 +765,7 @@ int PigeonIMU::GetFirmwareVersion() {
  */
 ErrorCode PigeonIMU::GetFaults(PigeonIMU_Faults & toFill) {
 	int faultBits;
-	ErrorCode retval = c_PigeonIMU_GetFaults(_handle, &faultBits);
+	ErrorCode retval = ErrorCounters::Count(_handle, c_PigeonIMU_GetFaults(_handle, &faultBits));
 	toFill = PigeonIMU_Faults(faultBits);
 	return retval;
 }
@@ -757,7 +778,7 @@ ErrorCode PigeonIMU::GetFaults(PigeonIMU_Faults & toFill) {
  */
 ErrorCode PigeonIMU::GetStickyFaults(PigeonIMU_StickyFaults & toFill) {
 	int faultBits;
-	ErrorCode retval = c_PigeonIMU_GetFaults(_handle, &faultBits);
+	ErrorCode retval = ErrorCounters::Count(_handle, c_PigeonIMU_GetFaults(_handle, &faultBits));
 	toFill = PigeonIMU_StickyFaults(faultBits);
 	return retval;
 }
@@ -767,7 +788,7 @@ ErrorCode PigeonIMU::GetStickyFaults(PigeonIMU_StickyFaults & toFill) {
  * @return Error Code generated by function. 0 indicates no error.
  */
 ErrorCode PigeonIMU::ClearStickyFaults(int timeoutMs) {
-	return c_PigeonIMU_ClearStickyFaults(_handle, timeoutMs);
+	return ErrorCounters::Count(_handle, c_PigeonIMU_ClearStickyFaults(_handle, timeoutMs));
 }
 
 } // namespace signals
@@ -1,19 +1,40 @@
 #include "ctre/phoenix/Stopwatch.h"
+#include "ctre/phoenix/MonotonicClock.h"
 
 namespace ctre {
 namespace phoenix {
 
+Stopwatch::Stopwatch() :
+		_t0(MonotonicClock::NowNs()) {
+}
 void Stopwatch::Start(){
-	_t0 = (float)clock();
+	_t0 = MonotonicClock::NowNs();
 }
+/**
+ * @return milliseconds since Start().
+ */
 unsigned int Stopwatch::DurationMs(){
-	return Stopwatch::Duration() * 1000;
+	return (unsigned int) (Stopwatch::DurationNs() / 1000000);
 }
+/**
+ * @return seconds since Start().
+ */
 float Stopwatch::Duration(){
-	_t1 = (float)clock();
-	long retval = _t1 - _t0;
+	return (float) (Stopwatch::DurationNs() * 1e-9);
+}
+/**
+ * @return microseconds since Start().
+ */
+int64_t Stopwatch::DurationUs(){
+	return Stopwatch::DurationNs() / 1000;
+}
+/**
+ * @return nanoseconds since Start().
+ */
+int64_t Stopwatch::DurationNs(){
+	int64_t retval = MonotonicClock::NowNs() - _t0;
 	if(retval < 0) retval = 0;
-	return retval * _scalar;
+	return retval;
 }
 
 } // namespace phoenix
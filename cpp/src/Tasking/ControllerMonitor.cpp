@@ -0,0 +1,199 @@
+#include "ctre/phoenix/Tasking/ControllerMonitor.h"
+#include <DriverStation.h> // WPILIB
+#include <GenericHID.h> // WPILIB
+
+#ifndef CTR_EXCLUDE_WPILIB_CLASSES
+
+namespace ctre {
+namespace phoenix {
+namespace tasking {
+
+/** lowest set bit, bits must be nonzero */
+static inline int LowestBit(uint32_t bits) {
+	return __builtin_ctz(bits);
+}
+
+/**
+ * @param controller controller to monitor, all buttons are read through the
+ *                   driver station using its port.
+ */
+ControllerMonitor::ControllerMonitor(frc::GenericHID * controller) {
+	_port = controller->GetPort();
+	Init();
+}
+/**
+ * @param port driver station joystick port to monitor.
+ */
+ControllerMonitor::ControllerMonitor(int port) {
+	_port = port;
+	Init();
+}
+void ControllerMonitor::Init() {
+	for (int i = 0; i < kMaxButtons; ++i) {
+		_handlers[i] = nullptr;
+		_debounceCnt[i] = 0;
+		_heldTicks[i] = 0;
+	}
+}
+/**
+ * Set the handler of a button, replacing any previous one.
+ * @param buttonIndex one-based button index [1,32].
+ * @param handler object to notify of edges.
+ * @param reportLongPress true to also report LongPressed once the button has
+ *                        been held for the long press time.
+ * @return false if button index is out of range.
+ */
+bool ControllerMonitor::Add(int buttonIndex, IButtonEventHandler * handler,
+		bool reportLongPress) {
+	if (buttonIndex < 1 || buttonIndex > kMaxButtons)
+		return false;
+	if (handler == nullptr) {
+		/* keep _handledMask in step with non-null handlers */
+		Remove(buttonIndex);
+		return true;
+	}
+	int bit = buttonIndex - 1;
+	uint32_t mask = (uint32_t) 1 << bit;
+	_handlers[bit] = handler;
+	_handledMask |= mask;
+	if (reportLongPress)
+		_longPressMask |= mask;
+	else
+		_longPressMask &= ~mask;
+	return true;
+}
+void ControllerMonitor::Remove(int buttonIndex) {
+	if (buttonIndex < 1 || buttonIndex > kMaxButtons)
+		return;
+	int bit = buttonIndex - 1;
+	uint32_t mask = (uint32_t) 1 << bit;
+	_handlers[bit] = nullptr;
+	_handledMask &= ~mask;
+	_longPressMask &= ~mask;
+}
+void ControllerMonitor::RemoveAll() {
+	for (int i = 0; i < kMaxButtons; ++i)
+		_handlers[i] = nullptr;
+	_handledMask = 0;
+	_longPressMask = 0;
+}
+/**
+ * @param ticks number of consecutive Process() calls a button must read its
+ *              new value before the change is accepted.  0 or 1 disables
+ *              debouncing.
+ */
+void ControllerMonitor::SetDebounceTicks(int ticks) {
+	if (ticks > 255)
+		ticks = 255;
+	_debounceTicks = ticks;
+}
+/**
+ * @param ticks number of Process() calls a button must be held (including the
+ *              press) before LongPressed is reported.
+ */
+void ControllerMonitor::SetLongPressTicks(int ticks) {
+	if (ticks < 1)
+		ticks = 1;
+	if (ticks > UINT16_MAX)
+		ticks = UINT16_MAX;
+	_longPressTicks = ticks;
+}
+/**
+ * @return debounced button word, bit 0 is button 1.
+ */
+uint32_t ControllerMonitor::GetButtons() const {
+	return _state;
+}
+bool ControllerMonitor::IsDown(int buttonIndex) const {
+	if (buttonIndex < 1 || buttonIndex > kMaxButtons)
+		return false;
+	return (_state >> (buttonIndex - 1)) & 1;
+}
+void ControllerMonitor::Dispatch(uint32_t bits, ButtonEvent evt) {
+	/* re-masked each time as a handler may unregister handlers */
+	while ((bits &= _handledMask) != 0) {
+		int bit = LowestBit(bits);
+		bits &= bits - 1;
+		_handlers[bit]->OnButtonEvent(bit + 1, evt);
+	}
+}
+/**
+ * Feed a raw button word, typically from the driver station.  Process() calls
+ * this, but it can be used directly to monitor any other source of buttons.
+ * @param rawButtons button word, bit 0 is button 1.
+ */
+void ControllerMonitor::Update(uint32_t rawButtons) {
+	uint32_t diff = rawButtons ^ _state;
+	uint32_t accepted;
+
+	if (_debounceTicks <= 1) {
+		accepted = diff;
+	} else {
+		/* buttons that bounced back to their old value start over */
+		uint32_t settled = _pending & ~diff;
+		while (settled) {
+			int bit = LowestBit(settled);
+			settled &= settled - 1;
+			_debounceCnt[bit] = 0;
+		}
+		accepted = 0;
+		uint32_t bits = diff;
+		while (bits) {
+			int bit = LowestBit(bits);
+			bits &= bits - 1;
+			if (++_debounceCnt[bit] >= _debounceTicks) {
+				_debounceCnt[bit] = 0;
+				accepted |= (uint32_t) 1 << bit;
+			}
+		}
+		_pending = diff & ~accepted;
+	}
+
+	_state ^= accepted;
+	uint32_t pressed = accepted & _state;
+	uint32_t released = accepted & ~_state;
+
+	/* long press tracking restarts on every press */
+	_longFired &= ~accepted;
+	uint32_t bits = pressed & _longPressMask;
+	while (bits) {
+		int bit = LowestBit(bits);
+		bits &= bits - 1;
+		_heldTicks[bit] = 0;
+	}
+
+	Dispatch(released, Released);
+	Dispatch(pressed, Pressed);
+
+	uint32_t longPressed = 0;
+	bits = _state & _longPressMask & ~_longFired;
+	while (bits) {
+		int bit = LowestBit(bits);
+		bits &= bits - 1;
+		if (++_heldTicks[bit] >= _longPressTicks)
+			longPressed |= (uint32_t) 1 << bit;
+	}
+	_longFired |= longPressed;
+	Dispatch(longPressed, LongPressed);
+}
+
+void ControllerMonitor::Process() {
+	Update((uint32_t) frc::DriverStation::GetInstance().GetStickButtons(_port));
+}
+
+void ControllerMonitor::OnStart() {
+}
+void ControllerMonitor::OnLoop() {
+	Process();
+}
+bool ControllerMonitor::IsDone() {
+	return false;
+}
+void ControllerMonitor::OnStop() {
+}
+
+} // namespace tasking
+} // namespace phoenix
+} // namespace ctre
+
+#endif // CTR_EXCLUDE_WPILIB_CLASSES
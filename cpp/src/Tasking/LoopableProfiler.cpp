@@ -0,0 +1,216 @@
+#include "ctre/phoenix/Tasking/LoopableProfiler.h"
+#include "ctre/phoenix/MonotonicClock.h"
+#include <stdio.h>
+
+namespace ctre {
+namespace phoenix {
+namespace tasking {
+
+/** quarter-octave bin, exact below 8ns */
+static inline int BinOf(uint32_t ns) {
+	if (ns < 8)
+		return (int) ns;
+	int msb = 31 - __builtin_clz(ns);
+	return msb * 4 + (int) ((ns >> (msb - 2)) & 3);
+}
+/** largest ns value that lands in bin */
+static inline uint64_t BinUpperNs(int bin) {
+	if (bin < 8)
+		return (uint64_t) bin;
+	int msb = bin / 4;
+	uint64_t frac = (uint64_t) (bin % 4);
+	return ((5 + frac) << (msb - 2)) - 1;
+}
+/** single writer, so plain load/store is enough and avoids locked ops */
+template<typename T>
+static inline void Bump(std::atomic<T> & a, T delta) {
+	a.store(a.load(std::memory_order_relaxed) + delta,
+			std::memory_order_relaxed);
+}
+
+/**
+ * Constructor
+ * @param capacity number of slots, storage is allocated here.
+ * @param overrunThresholdUs calls taking longer than this count as overruns.
+ */
+LoopableProfiler::LoopableProfiler(int capacity, int overrunThresholdUs) {
+	_capacity = (capacity > 0) ? capacity : 0;
+	_slots = new Slot[_capacity];
+	_overrunThresholdNs = (uint32_t) overrunThresholdUs * 1000;
+	Reset();
+}
+LoopableProfiler::~LoopableProfiler() {
+	delete[] _slots;
+	_slots = 0;
+}
+/**
+ * Call loop->OnStart(), timing it into slot.
+ */
+void LoopableProfiler::OnStart(int slot, ILoopable * loop) {
+	if (slot < 0 || slot >= _capacity) {
+		loop->OnStart();
+		return;
+	}
+	int64_t start = MonotonicClock::NowNs();
+	loop->OnStart();
+	int64_t end = MonotonicClock::NowNs();
+	_slots[slot].loop.store(loop, std::memory_order_relaxed);
+	Record(_slots[slot].onStart, end - start);
+}
+/**
+ * Call loop->OnLoop(), timing it into slot.
+ */
+void LoopableProfiler::OnLoop(int slot, ILoopable * loop) {
+	if (slot < 0 || slot >= _capacity) {
+		loop->OnLoop();
+		return;
+	}
+	int64_t start = MonotonicClock::NowNs();
+	loop->OnLoop();
+	int64_t end = MonotonicClock::NowNs();
+	_slots[slot].loop.store(loop, std::memory_order_relaxed);
+	Record(_slots[slot].onLoop, end - start);
+}
+/**
+ * Call loop->OnStop(), timing it into slot.
+ */
+void LoopableProfiler::OnStop(int slot, ILoopable * loop) {
+	if (slot < 0 || slot >= _capacity) {
+		loop->OnStop();
+		return;
+	}
+	int64_t start = MonotonicClock::NowNs();
+	loop->OnStop();
+	int64_t end = MonotonicClock::NowNs();
+	_slots[slot].loop.store(loop, std::memory_order_relaxed);
+	Record(_slots[slot].onStop, end - start);
+}
+void LoopableProfiler::Record(Counters & counters, int64_t elapsedNs) {
+	uint32_t ns = (elapsedNs < UINT32_MAX) ? (uint32_t) elapsedNs : UINT32_MAX;
+	Bump(counters.calls, 1u);
+	Bump(counters.sumNs, (uint64_t) ns);
+	if (ns < counters.minNs.load(std::memory_order_relaxed))
+		counters.minNs.store(ns, std::memory_order_relaxed);
+	if (ns > counters.maxNs.load(std::memory_order_relaxed))
+		counters.maxNs.store(ns, std::memory_order_relaxed);
+	if (ns > _overrunThresholdNs)
+		Bump(counters.overruns, 1u);
+	Bump(counters.histogram[BinOf(ns)], 1u);
+}
+int LoopableProfiler::GetCapacity() const {
+	return _capacity;
+}
+void LoopableProfiler::FillCallStats(const Counters & counters,
+		CallStats & toFill) {
+	uint32_t calls = counters.calls.load(std::memory_order_relaxed);
+	uint32_t maxNs = counters.maxNs.load(std::memory_order_relaxed);
+	toFill.calls = calls;
+	toFill.overruns = counters.overruns.load(std::memory_order_relaxed);
+	toFill.minUs = (calls > 0) ?
+			counters.minNs.load(std::memory_order_relaxed) / 1000 : 0;
+	toFill.meanUs = (calls > 0) ?
+			(uint32_t) (counters.sumNs.load(std::memory_order_relaxed) / calls
+					/ 1000) : 0;
+	toFill.maxUs = maxNs / 1000;
+
+	/* walk histogram until 99% of calls are covered */
+	uint64_t p99Ns = 0;
+	uint64_t target = ((uint64_t) calls * 99 + 99) / 100;
+	uint64_t seen = 0;
+	for (int i = 0; i < kHistogramBins && target > 0; ++i) {
+		seen += counters.histogram[i].load(std::memory_order_relaxed);
+		if (seen >= target) {
+			p99Ns = BinUpperNs(i);
+			break;
+		}
+	}
+	if (p99Ns > maxNs)
+		p99Ns = maxNs;
+	toFill.p99Us = (uint32_t) (p99Ns / 1000);
+}
+/**
+ * Snapshot one slot.  Safe to call from any thread, individual counters may
+ * be one call apart from each other.
+ * @return false if slot is out of range.
+ */
+bool LoopableProfiler::GetStats(int slot, Stats & toFill) const {
+	if (slot < 0 || slot >= _capacity)
+		return false;
+	const Slot & s = _slots[slot];
+	toFill.loopable = s.loop.load(std::memory_order_relaxed);
+	FillCallStats(s.onStart, toFill.onStart);
+	FillCallStats(s.onLoop, toFill.onLoop);
+	FillCallStats(s.onStop, toFill.onStop);
+	return true;
+}
+/**
+ * Print a table of every slot that has been called into buffer.
+ * Times are in microseconds.
+ * @return number of characters written, not including the null terminator.
+ */
+int LoopableProfiler::Dump(char * buffer, int capacity) const {
+	if (buffer == nullptr || capacity <= 0)
+		return 0;
+	int len = 0;
+	buffer[0] = 0;
+
+	int n = snprintf(buffer, capacity,
+			"slot  callback      calls     min    mean     p99     max  overruns\n");
+	len += n;
+
+	static const char * const names[] = { "OnStart", "OnLoop", "OnStop" };
+	Stats stats;
+	for (int i = 0; i < _capacity && len < capacity; ++i) {
+		GetStats(i, stats);
+		if (stats.loopable == nullptr)
+			continue;
+		const CallStats * calls[] = { &stats.onStart, &stats.onLoop,
+				&stats.onStop };
+		for (int j = 0; j < 3 && len < capacity; ++j) {
+			if (calls[j]->calls == 0)
+				continue;
+			n = snprintf(buffer + len, capacity - len,
+					"%4d  %-8s %10u %7u %7u %7u %7u %9u\n", i, names[j],
+					calls[j]->calls, calls[j]->minUs, calls[j]->meanUs,
+					calls[j]->p99Us, calls[j]->maxUs, calls[j]->overruns);
+			len += n;
+		}
+	}
+	/* snprintf reports what would have been written, clamp to truncation */
+	if (len >= capacity)
+		len = capacity - 1;
+	return len;
+}
+void LoopableProfiler::ResetCounters(Counters & counters) {
+	counters.calls = 0;
+	counters.overruns = 0;
+	counters.minNs = UINT32_MAX;
+	counters.maxNs = 0;
+	counters.sumNs = 0;
+	for (int i = 0; i < kHistogramBins; ++i)
+		counters.histogram[i] = 0;
+}
+/**
+ * Clear all slots.  Should be called from the scheduler's thread, or while
+ * the scheduler is not processing.
+ */
+void LoopableProfiler::Reset() {
+	for (int i = 0; i < _capacity; ++i)
+		Reset(i);
+}
+/**
+ * Clear one slot, e.g. when the scheduler hands it to another loopable.
+ * Same threading rules as Reset().
+ */
+void LoopableProfiler::Reset(int slot) {
+	if (slot < 0 || slot >= _capacity)
+		return;
+	_slots[slot].loop = nullptr;
+	ResetCounters(_slots[slot].onStart);
+	ResetCounters(_slots[slot].onLoop);
+	ResetCounters(_slots[slot].onStop);
+}
+
+} // namespace tasking
+} // namespace phoenix
+} // namespace ctre
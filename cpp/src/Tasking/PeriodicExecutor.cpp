@@ -0,0 +1,195 @@
+#include "ctre/phoenix/Tasking/PeriodicExecutor.h"
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+
+namespace ctre {
+namespace phoenix {
+namespace tasking {
+
+static const int64_t kNsPerSec = 1000000000;
+
+static void AddNs(struct timespec & ts, int64_t ns) {
+	ns += ts.tv_nsec;
+	ts.tv_sec += ns / kNsPerSec;
+	ts.tv_nsec = ns % kNsPerSec;
+}
+static int64_t DiffNs(const struct timespec & a, const struct timespec & b) {
+	return (a.tv_sec - b.tv_sec) * kNsPerSec + (a.tv_nsec - b.tv_nsec);
+}
+
+/**
+ * Constructor
+ * @param loopable object to drive, OnStart/OnLoop/OnStop are all called from
+ *                 the executor's thread.
+ * @param periodUs tick period in microseconds.
+ */
+PeriodicExecutor::PeriodicExecutor(ILoopable * loopable, int periodUs) :
+		_running(false) {
+	_loopable = loopable;
+	_periodNs = (int64_t) periodUs * 1000;
+	/* histograms span two periods */
+	_binWidthUs = (uint32_t) (periodUs * 2) / kHistogramBins;
+	if (_binWidthUs < 1)
+		_binWidthUs = 1;
+	ResetStats();
+}
+PeriodicExecutor::~PeriodicExecutor() {
+	Stop();
+}
+/**
+ * @param priority SCHED_FIFO priority [1,99], or 0 for normal scheduling.
+ *                 Takes effect on next Start().
+ */
+void PeriodicExecutor::SetRealtimePriority(int priority) {
+	_priority = priority;
+}
+/**
+ * @param cpu core to pin the thread to, or -1 for no affinity.
+ *            Takes effect on next Start().
+ */
+void PeriodicExecutor::SetCpuAffinity(int cpu) {
+	_cpu = cpu;
+}
+/**
+ * Spawn the thread and call OnStart.
+ * @return false if already running.
+ */
+bool PeriodicExecutor::Start() {
+	if (_running)
+		return false;
+	/* loopable may have finished on its own, reap that thread */
+	if (_thread.joinable())
+		_thread.join();
+	_running = true;
+	_thread = std::thread(&PeriodicExecutor::Run, this);
+	return true;
+}
+/**
+ * Request the thread to finish the current tick, call OnStop, then join it.
+ */
+void PeriodicExecutor::Stop() {
+	_running = false;
+	if (_thread.joinable())
+		_thread.join();
+}
+bool PeriodicExecutor::IsRunning() const {
+	return _running;
+}
+void PeriodicExecutor::ApplyThreadSettings() {
+	if (_priority > 0) {
+		struct sched_param param;
+		param.sched_priority = _priority;
+		/* requires privileges, continue at normal priority otherwise */
+		(void) pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+	}
+	if (_cpu >= 0) {
+		cpu_set_t cpus;
+		CPU_ZERO(&cpus);
+		CPU_SET(_cpu, &cpus);
+		(void) pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+	}
+}
+void PeriodicExecutor::Run() {
+	ApplyThreadSettings();
+
+	_loopable->OnStart();
+
+	struct timespec deadline;
+	clock_gettime(CLOCK_MONOTONIC, &deadline);
+
+	while (_running) {
+		AddNs(deadline, _periodNs);
+		while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline,
+				nullptr) == EINTR) {
+			/* interrupted by signal, sleep the remainder */
+		}
+
+		struct timespec start, end;
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		_loopable->OnLoop();
+		clock_gettime(CLOCK_MONOTONIC, &end);
+
+		int64_t jitterNs = DiffNs(start, deadline);
+		if (jitterNs < 0)
+			jitterNs = 0;
+		Record((uint32_t) (jitterNs / 1000),
+				(uint32_t) (DiffNs(end, start) / 1000));
+
+		/* if we ran past the next deadline, skip those rather than bursting */
+		int64_t lateNs = DiffNs(end, deadline);
+		if (lateNs >= _periodNs) {
+			++_overruns;
+			int64_t missed = lateNs / _periodNs;
+			_missedDeadlines += (uint32_t) missed;
+			AddNs(deadline, missed * _periodNs);
+		}
+
+		if (_loopable->IsDone())
+			break;
+	}
+
+	_loopable->OnStop();
+	_running = false;
+}
+void PeriodicExecutor::Record(uint32_t jitterUs, uint32_t execUs) {
+	++_ticks;
+
+	if (jitterUs < _minJitterUs)
+		_minJitterUs = jitterUs;
+	if (jitterUs > _maxJitterUs)
+		_maxJitterUs = jitterUs;
+	_sumJitterUs += jitterUs;
+	if (execUs > _maxExecUs)
+		_maxExecUs = execUs;
+	_sumExecUs += execUs;
+
+	uint32_t bin = jitterUs / _binWidthUs;
+	if (bin >= (uint32_t) kHistogramBins)
+		bin = kHistogramBins - 1;
+	_jitterHistogram[bin].fetch_add(1, std::memory_order_relaxed);
+
+	bin = execUs / _binWidthUs;
+	if (bin >= (uint32_t) kHistogramBins)
+		bin = kHistogramBins - 1;
+	_execHistogram[bin].fetch_add(1, std::memory_order_relaxed);
+}
+/**
+ * Snapshot statistics.  Safe to call from any thread, individual counters may
+ * be one tick apart from each other.
+ */
+void PeriodicExecutor::GetStats(Stats & toFill) const {
+	uint32_t ticks = _ticks;
+	toFill.ticks = ticks;
+	toFill.overruns = _overruns;
+	toFill.missedDeadlines = _missedDeadlines;
+	toFill.minJitterUs = (ticks > 0) ? (uint32_t) _minJitterUs : 0;
+	toFill.maxJitterUs = _maxJitterUs;
+	toFill.meanJitterUs = (ticks > 0) ? (uint32_t) (_sumJitterUs / ticks) : 0;
+	toFill.maxExecUs = _maxExecUs;
+	toFill.meanExecUs = (ticks > 0) ? (uint32_t) (_sumExecUs / ticks) : 0;
+	toFill.histogramBinWidthUs = _binWidthUs;
+	for (int i = 0; i < kHistogramBins; ++i) {
+		toFill.jitterHistogram[i] = _jitterHistogram[i];
+		toFill.execHistogram[i] = _execHistogram[i];
+	}
+}
+void PeriodicExecutor::ResetStats() {
+	_ticks = 0;
+	_overruns = 0;
+	_missedDeadlines = 0;
+	_minJitterUs = UINT32_MAX;
+	_maxJitterUs = 0;
+	_sumJitterUs = 0;
+	_maxExecUs = 0;
+	_sumExecUs = 0;
+	for (int i = 0; i < kHistogramBins; ++i) {
+		_jitterHistogram[i] = 0;
+		_execHistogram[i] = 0;
+	}
+}
+
+} // namespace tasking
+} // namespace phoenix
+} // namespace ctre
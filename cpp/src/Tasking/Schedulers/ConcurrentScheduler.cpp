@@ -5,67 +5,351 @@ namespace phoenix {
 namespace tasking {
 namespace schedulers {
 
-ConcurrentScheduler::ConcurrentScheduler() {
+/**
+ * Constructor
+ * @param commandQueueCapacity number of Post commands that can be pending
+ *                             between two Process() calls.
+ */
+ConcurrentScheduler::ConcurrentScheduler(int commandQueueCapacity) :
+		_commands(commandQueueCapacity > 0 ? commandQueueCapacity : 1), _droppedCommands(
+				0) {
 }
 ConcurrentScheduler::~ConcurrentScheduler() {
 }
-void ConcurrentScheduler::Add(ILoopable *aLoop, bool enable) {
-	_loops.push_back(aLoop);
-	_enabs.push_back(enable);
+/**
+ * @return slot of handle, or -1 if handle is invalid, stale or removed.
+ */
+int ConcurrentScheduler::Find(Handle handle) const {
+	if (handle < 0)
+		return -1;
+	int slot = GetSlot(handle);
+	if (slot >= (int) _entries.size())
+		return -1;
+	const Entry & entry = _entries[slot];
+	if (entry.loop == nullptr || entry.generation != (handle >> kSlotBits))
+		return -1;
+	return slot;
+}
+/**
+ * @param aLoop loopable to add.
+ * @param enable true to have OnLoop called each Process().  OnStart is not
+ *               called, use Start() for that.
+ * @return handle for Start/Stop/IsStarted, -1 if kMaxSlots loopables are
+ *         already added.
+ */
+ConcurrentScheduler::Handle ConcurrentScheduler::Add(ILoopable *aLoop,
+		bool enable) {
+	int slot;
+	if (!_freeSlots.empty()) {
+		slot = _freeSlots.back();
+		_freeSlots.pop_back();
+		/* previous occupant's timings don't belong to this loopable */
+		if (_profiler != nullptr)
+			_profiler->Reset(slot);
+	} else if ((int) _entries.size() < kMaxSlots) {
+		slot = (int) _entries.size();
+		Entry blank;
+		blank.loop = nullptr;
+		blank.activeIdx = -1;
+		blank.generation = 0;
+		blank.lastTick = 0;
+		_entries.push_back(blank);
+	} else {
+		return -1;
+	}
+	Entry & entry = _entries[slot];
+	entry.loop = aLoop;
+	entry.activeIdx = -1;
+	/* a recycled slot may have run this tick, the new loopable hasn't */
+	entry.lastTick = _tick - 1;
+	Handle handle = (entry.generation << kSlotBits) | slot;
+	_handles[aLoop] = handle;
+	if (enable)
+		Enable(slot);
+	return handle;
+}
+void ConcurrentScheduler::Remove(ILoopable *toRemove) {
+	auto it = _handles.find(toRemove);
+	if (it != _handles.end())
+		Remove(it->second);
+}
+/**
+ * Forget a loopable, OnStop is not called.  Its handle becomes invalid, the
+ * slot is recycled by a later Add() under a new handle.
+ */
+void ConcurrentScheduler::Remove(Handle handle) {
+	int slot = Find(handle);
+	if (slot < 0)
+		return;
+	Entry & entry = _entries[slot];
+	_wheel.Cancel(slot);
+	Disable(slot);
+	auto it = _handles.find(entry.loop);
+	if (it != _handles.end() && it->second == handle)
+		_handles.erase(it);
+	entry.loop = nullptr;
+	/* 15 bits of generation keep handles non-negative */
+	entry.generation = (entry.generation + 1) & 0x7FFF;
+	_freeSlots.push_back(slot);
 }
 void ConcurrentScheduler::RemoveAll() {
-	_loops.clear();
-	_enabs.clear();
+	for (int slot = 0; slot < (int) _entries.size(); ++slot) {
+		Entry & entry = _entries[slot];
+		if (entry.loop != nullptr)
+			Remove((entry.generation << kSlotBits) | slot);
+	}
 }
-void ConcurrentScheduler::Start(ILoopable* toStart) {
-	for (int i = 0; i < (int) _loops.size(); ++i) {
-		ILoopable* lp = (ILoopable*) _loops[i];
-
-		if (lp == toStart) {
-			_enabs[i] = true;
-			lp->OnStart();
-			return;
-		}
+void ConcurrentScheduler::Enable(int slot) {
+	Entry & entry = _entries[slot];
+	if (entry.activeIdx < 0) {
+		entry.activeIdx = (int) _active.size();
+		_active.push_back(entry.loop);
+		_activeSlots.push_back(slot);
 	}
-
 }
-void ConcurrentScheduler::Stop(ILoopable* toStop) {
-	for (int i = 0; i < (int) _loops.size(); ++i) {
-		ILoopable* lp = (ILoopable*) _loops[i];
-
-		if (lp == toStop) {
-			_enabs[i] = false;
-			lp->OnStop();
-			return;
-		}
+void ConcurrentScheduler::Disable(int slot) {
+	Entry & entry = _entries[slot];
+	int idx = entry.activeIdx;
+	if (idx < 0)
+		return;
+	entry.activeIdx = -1;
+	if (_iterating) {
+		/* moving the last one here could make it miss this tick, leave a
+		 * hole for Process() to close afterwards */
+		_active[idx] = nullptr;
+		_activeSlots[idx] = -1;
+		++_holes;
+		return;
 	}
+	/* move last one into the hole */
+	int last = (int) _active.size() - 1;
+	_active[idx] = _active[last];
+	_activeSlots[idx] = _activeSlots[last];
+	if (idx != last)
+		_entries[_activeSlots[idx]].activeIdx = idx;
+	_active.pop_back();
+	_activeSlots.pop_back();
 }
-void ConcurrentScheduler::StartAll() {	//All Loops
-	for (auto loop : _loops) {
-		loop->OnStart();
+/** squeeze out holes left by Disable() during Process(), keeping order */
+void ConcurrentScheduler::CloseHoles() {
+	int out = 0;
+	for (int i = 0; i < (int) _active.size(); ++i) {
+		if (_active[i] == nullptr)
+			continue;
+		_active[out] = _active[i];
+		_activeSlots[out] = _activeSlots[i];
+		_entries[_activeSlots[out]].activeIdx = out;
+		++out;
 	}
-	for (auto enable : _enabs) {
-		enable = true;
+	_active.resize(out);
+	_activeSlots.resize(out);
+	_holes = 0;
+}
+void ConcurrentScheduler::Start(ILoopable* toStart) {
+	auto it = _handles.find(toStart);
+	if (it != _handles.end())
+		Start(it->second);
+}
+void ConcurrentScheduler::Stop(ILoopable* toStop) {
+	auto it = _handles.find(toStop);
+	if (it != _handles.end())
+		Stop(it->second);
+}
+void ConcurrentScheduler::Start(Handle handle) {
+	int slot = Find(handle);
+	if (slot < 0)
+		return;
+	_wheel.Cancel(slot);
+	Enable(slot);
+	CallOnStart(slot);
+}
+void ConcurrentScheduler::Stop(Handle handle) {
+	int slot = Find(handle);
+	if (slot < 0)
+		return;
+	_wheel.Cancel(slot);
+	Disable(slot);
+	CallOnStop(slot);
+}
+void ConcurrentScheduler::StartAll() {	//All Loops
+	_wheel.CancelAll();
+	for (int slot = 0; slot < (int) _entries.size(); ++slot) {
+		if (_entries[slot].loop == nullptr)
+			continue;
+		Enable(slot);
+		CallOnStart(slot);
 	}
 }
 void ConcurrentScheduler::StopAll() {	//All Loops
-	for (auto loop : _loops) {
-		loop->OnStop();
+	_wheel.CancelAll();
+	for (int slot = 0; slot < (int) _entries.size(); ++slot) {
+		if (_entries[slot].loop == nullptr)
+			continue;
+		Disable(slot);
+		CallOnStop(slot);
 	}
-	for (auto enable : _enabs) {
-		enable = false;
+}
+bool ConcurrentScheduler::IsStarted(Handle handle) const {
+	int slot = Find(handle);
+	return slot >= 0 && _entries[slot].activeIdx >= 0;
+}
+int ConcurrentScheduler::GetCount() const {
+	return (int) _handles.size();
+}
+int ConcurrentScheduler::GetStartedCount() const {
+	return (int) _active.size() - _holes;
+}
+/**
+ * @param profiler profiler to time every callback with, or null to stop
+ *                 profiling.  Caller keeps ownership.
+ */
+void ConcurrentScheduler::SetProfiler(LoopableProfiler * profiler) {
+	_profiler = profiler;
+}
+void ConcurrentScheduler::CallOnStart(int slot) {
+	if (_profiler == nullptr)
+		_entries[slot].loop->OnStart();
+	else
+		_profiler->OnStart(slot, _entries[slot].loop);
+}
+void ConcurrentScheduler::CallOnStop(int slot) {
+	if (_profiler == nullptr)
+		_entries[slot].loop->OnStop();
+	else
+		_profiler->OnStop(slot, _entries[slot].loop);
+}
+/**
+ * Suspend a started loopable for a number of ticks.  It is not stopped, so
+ * OnStop/OnStart are not called, OnLoop just isn't called until it wakes.
+ * Can be called from the loopable's own OnLoop.
+ * @param handle loopable to suspend.
+ * @param ticks number of Process() calls to skip it for, minimum 1.
+ */
+void ConcurrentScheduler::Sleep(Handle handle, int ticks) {
+	int slot = Find(handle);
+	if (slot < 0)
+		return;
+	if (_entries[slot].activeIdx < 0 && !_wheel.IsScheduled(slot))
+		return;
+	Disable(slot);
+	/* Process() advances the wheel before running loopables, so one more
+	 * tick is needed for the loopable to actually miss 'ticks' of them */
+	_wheel.Schedule(slot, (uint32_t) ((ticks > 0) ? ticks : 1) + 1);
+}
+/**
+ * Resume a sleeping loopable now.
+ */
+void ConcurrentScheduler::Wake(Handle handle) {
+	int slot = Find(handle);
+	if (slot < 0 || !_wheel.IsScheduled(slot))
+		return;
+	_wheel.Cancel(slot);
+	Enable(slot);
+}
+bool ConcurrentScheduler::IsSleeping(Handle handle) const {
+	int slot = Find(handle);
+	return slot >= 0 && _wheel.IsScheduled(slot);
+}
+void ConcurrentScheduler::OnTimerExpired(int id) {
+	Enable(id);
+}
+bool ConcurrentScheduler::Post(CommandType type, ILoopable * loop,
+		bool enable) {
+	Command cmd;
+	cmd.type = type;
+	cmd.loop = loop;
+	cmd.enable = enable;
+	if (_commands.TryPush(cmd))
+		return true;
+	_droppedCommands.fetch_add(1, std::memory_order_relaxed);
+	return false;
+}
+/**
+ * Queue an Add() from any thread, applied at the start of the next Process().
+ * Never blocks.
+ * @return false if the command queue is full and the command was dropped.
+ */
+bool ConcurrentScheduler::PostAdd(ILoopable *aLoop, bool enable) {
+	return Post(CmdAdd, aLoop, enable);
+}
+/**
+ * Queue a Start() from any thread, see PostAdd().
+ */
+bool ConcurrentScheduler::PostStart(ILoopable *toStart) {
+	return Post(CmdStart, toStart, true);
+}
+/**
+ * Queue a Stop() from any thread, see PostAdd().
+ */
+bool ConcurrentScheduler::PostStop(ILoopable *toStop) {
+	return Post(CmdStop, toStop, false);
+}
+/**
+ * Queue a Remove() from any thread, see PostAdd().
+ * The scheduler keeps using the loopable until the next Process() applies
+ * the command, OnLoop() may even be running at the time of the call.  The
+ * caller still owns it and must not destroy it before that Process() has
+ * returned, e.g. by deleting it from the scheduler's thread after
+ * Process().
+ */
+bool ConcurrentScheduler::PostRemove(ILoopable *toRemove) {
+	return Post(CmdRemove, toRemove, false);
+}
+/**
+ * @return number of Post commands dropped because the queue was full.
+ */
+uint32_t ConcurrentScheduler::GetDroppedCommandCount() const {
+	return _droppedCommands.load(std::memory_order_relaxed);
+}
+void ConcurrentScheduler::ApplyCommands() {
+	Command cmd;
+	while (_commands.TryPop(cmd)) {
+		switch (cmd.type) {
+		case CmdAdd:
+			Add(cmd.loop, cmd.enable);
+			break;
+		case CmdStart:
+			Start(cmd.loop);
+			break;
+		case CmdStop:
+			Stop(cmd.loop);
+			break;
+		case CmdRemove:
+			Remove(cmd.loop);
+			break;
+		}
 	}
 }
 void ConcurrentScheduler::Process() {
-	for (int i = 0; i < (int) _loops.size(); ++i) {
-		ILoopable* loop = (ILoopable*) _loops[i];
-		bool en = (bool) _enabs[i];
-		if (en) {
+	ApplyCommands();
+
+	/* put back loopables whose sleep is over */
+	if (_wheel.GetScheduledCount() > 0)
+		_wheel.Advance(this);
+
+	/* size is re-read so a loopable may start, stop or sleep itself or
+	 * others.  Stopped ones leave a hole instead of being swapped with the
+	 * last, so nothing still started is skipped this tick.  One stopped and
+	 * started again is appended, the tick stamp keeps it from running twice */
+	++_tick;
+	_iterating = true;
+	for (unsigned int i = 0; i < _active.size(); ++i) {
+		ILoopable * loop = _active[i];
+		if (loop == nullptr)
+			continue;
+		int slot = _activeSlots[i];
+		Entry & entry = _entries[slot];
+		if (entry.lastTick == _tick)
+			continue;
+		entry.lastTick = _tick;
+		if (_profiler == nullptr)
 			loop->OnLoop();
-		} else {
-			/* Current ILoopable is turned off, don't call OnLoop for it */
-		}
+		else
+			_profiler->OnLoop(slot, loop);
 	}
+	_iterating = false;
+	if (_holes > 0)
+		CloseHoles();
 }
 /* ILoopable */
 void ConcurrentScheduler::OnStart() {
@@ -0,0 +1,129 @@
+#include "ctre/phoenix/Tasking/Schedulers/ParallelGroup.h"
+
+namespace ctre {
+namespace phoenix {
+namespace tasking {
+namespace schedulers {
+
+/**
+ * Constructor
+ * @param mode when the group is considered done.
+ * @param workerThreads threads to run children's OnLoop on, 0 to run them
+ *                      on the calling thread.
+ */
+ParallelGroup::ParallelGroup(Mode mode, int workerThreads) {
+	_mode = mode;
+	if (workerThreads > 0)
+		_pool.reset(new ParallelScheduler(workerThreads));
+}
+ParallelGroup::~ParallelGroup() {
+}
+/**
+ * @param aLoop child to run.
+ * @param isDeadline true if this child decides when a Deadline group is
+ *                   done.  If none is flagged, the first child is used.
+ */
+void ParallelGroup::Add(ILoopable *aLoop, bool isDeadline) {
+	Child child;
+	child.loop = aLoop;
+	child.running = false;
+	_children.push_back(child);
+	if (isDeadline)
+		_deadlineIdx = (int) _children.size() - 1;
+	if (_pool)
+		_pool->Add(aLoop, false);
+}
+void ParallelGroup::RemoveAll() {
+	_children.clear();
+	_deadlineIdx = -1;
+	_running = 0;
+	if (_pool)
+		_pool->RemoveAll();
+}
+ParallelGroup::Mode ParallelGroup::GetMode() const {
+	return _mode;
+}
+/**
+ * @return number of children that have not finished or been stopped.
+ */
+int ParallelGroup::GetRunningCount() const {
+	return _running;
+}
+void ParallelGroup::StopChild(Child & child) {
+	if (!child.running)
+		return;
+	child.running = false;
+	--_running;
+	if (_pool)
+		_pool->Stop(child.loop); /* disables it and calls OnStop */
+	else
+		child.loop->OnStop();
+}
+void ParallelGroup::StopRemaining() {
+	for (auto & child : _children)
+		StopChild(child);
+}
+/* ILoopable */
+void ParallelGroup::OnStart() {
+	_running = 0;
+	for (auto & child : _children) {
+		child.running = true;
+		++_running;
+		if (_pool)
+			_pool->Start(child.loop); /* enables it and calls OnStart */
+		else
+			child.loop->OnStart();
+	}
+	_done = (_running == 0);
+}
+void ParallelGroup::OnLoop() {
+	if (_done)
+		return;
+
+	if (_pool) {
+		_pool->Process();
+	} else {
+		for (auto & child : _children) {
+			if (child.running)
+				child.loop->OnLoop();
+		}
+	}
+
+	/* retire finished children */
+	bool anyDone = false;
+	for (auto & child : _children) {
+		if (child.running && child.loop->IsDone()) {
+			StopChild(child);
+			anyDone = true;
+		}
+	}
+
+	switch (_mode) {
+	case All:
+		_done = (_running == 0);
+		break;
+	case Race:
+		_done = anyDone;
+		break;
+	case Deadline: {
+		int idx = (_deadlineIdx >= 0) ? _deadlineIdx : 0;
+		_done = !_children[idx].running;
+		break;
+	}
+	}
+	if (_done)
+		StopRemaining();
+}
+void ParallelGroup::OnStop() {
+	/* interrupted, or already done in which case nothing is left running */
+	StopRemaining();
+	_done = true;
+}
+bool ParallelGroup::IsDone() {
+	return _done;
+}
+
+} // namespace schedulers
+} // namespace tasking
+} // namespace phoenix
+} // namespace ctre
@@ -0,0 +1,280 @@
+#include "ctre/phoenix/Tasking/Schedulers/ParallelScheduler.h"
+
+namespace ctre {
+namespace phoenix {
+namespace tasking {
+namespace schedulers {
+
+/**
+ * Constructor
+ * @param workerThreads number of threads to create in addition to the
+ *                      thread calling Process().
+ */
+ParallelScheduler::ParallelScheduler(int workerThreads) :
+		_remaining(0), _readyCount(0), _sleepers(0) {
+	if (workerThreads < 0)
+		workerThreads = 0;
+	_queueCount = workerThreads + 1;
+	_queues.reset(new WorkQueue[_queueCount]);
+
+	/* queue 0 belongs to the caller of Process() */
+	for (int i = 1; i < _queueCount; ++i) {
+		_workers.push_back(std::thread(&ParallelScheduler::WorkerMain, this, i));
+	}
+}
+ParallelScheduler::~ParallelScheduler() {
+	{
+		std::unique_lock<std::mutex> lck(_tickLock);
+		_quit = true;
+	}
+	_tickStart.notify_all();
+	for (auto & worker : _workers) {
+		worker.join();
+	}
+}
+/**
+ * @param aLoop loopable to add.
+ * @param enable true to have OnLoop called each Process().
+ * @param startQueue index of the queue this loopable is put in at the start
+ *                   of each tick, [0,workerThreads], 0 being the thread
+ *                   calling Process().  -1 distributes round robin.  This
+ *                   only picks the first queue to look in: the loopable can
+ *                   still be stolen by any other thread, a loopable waiting
+ *                   on a dependency goes to whichever thread released it,
+ *                   and no thread is pinned to a core.
+ */
+void ParallelScheduler::Add(ILoopable *aLoop, bool enable, int startQueue) {
+	_nodes.emplace_back();
+	Node & node = _nodes.back();
+	node.loop = aLoop;
+	node.enabled = enable;
+	node.startQueue = startQueue;
+	node.pending = 0;
+}
+/**
+ * Within each tick, finish first->OnLoop() before starting then->OnLoop().
+ * If first is stopped, then runs without waiting on it.
+ * Both loopables must already be added.
+ * @return false if either isn't added, or if the edge would form a cycle
+ *         (which would stall Process() forever).  Nothing is added then.
+ */
+bool ParallelScheduler::AddDependency(ILoopable *first, ILoopable *then) {
+	int a = Find(first);
+	int b = Find(then);
+	if (a < 0 || b < 0 || a == b)
+		return false;
+	if (Reaches(b, a))
+		return false;
+	_nodes[a].successors.push_back(b);
+	return true;
+}
+/** @return true if 'to' can be reached from 'from' along dependency edges */
+bool ParallelScheduler::Reaches(int from, int to) const {
+	std::vector<bool> visited(_nodes.size(), false);
+	std::vector<int> stack;
+	stack.push_back(from);
+	visited[from] = true;
+	while (!stack.empty()) {
+		int n = stack.back();
+		stack.pop_back();
+		if (n == to)
+			return true;
+		for (int succ : _nodes[n].successors) {
+			if (!visited[succ]) {
+				visited[succ] = true;
+				stack.push_back(succ);
+			}
+		}
+	}
+	return false;
+}
+void ParallelScheduler::RemoveAll() {
+	_nodes.clear();
+}
+int ParallelScheduler::Find(ILoopable * loop) const {
+	for (int i = 0; i < (int) _nodes.size(); ++i) {
+		if (_nodes[i].loop == loop)
+			return i;
+	}
+	return -1;
+}
+void ParallelScheduler::Start(ILoopable *toStart) {
+	int i = Find(toStart);
+	if (i >= 0) {
+		_nodes[i].enabled = true;
+		toStart->OnStart();
+	}
+}
+void ParallelScheduler::Stop(ILoopable *toStop) {
+	int i = Find(toStop);
+	if (i >= 0) {
+		_nodes[i].enabled = false;
+		toStop->OnStop();
+	}
+}
+void ParallelScheduler::StartAll() {
+	for (auto & node : _nodes) {
+		node.loop->OnStart();
+		node.enabled = true;
+	}
+}
+void ParallelScheduler::StopAll() {
+	for (auto & node : _nodes) {
+		node.loop->OnStop();
+		node.enabled = false;
+	}
+}
+void ParallelScheduler::Push(int queueIdx, int nodeIdx) {
+	WorkQueue & q = _queues[queueIdx];
+	{
+		std::unique_lock<std::mutex> lck(q.lock);
+		q.ready.push_back(nodeIdx);
+	}
+	_readyCount.fetch_add(1);
+	if (_sleepers.load() > 0)
+		WakeParked(false);
+}
+/** owner takes newest work, keeps dependents on the same core */
+bool ParallelScheduler::TryPop(int queueIdx, int & nodeIdx) {
+	WorkQueue & q = _queues[queueIdx];
+	std::unique_lock<std::mutex> lck(q.lock);
+	if (q.ready.empty())
+		return false;
+	nodeIdx = q.ready.back();
+	q.ready.pop_back();
+	_readyCount.fetch_sub(1);
+	return true;
+}
+/** thieves take the oldest work from the other queues */
+bool ParallelScheduler::TrySteal(int queueIdx, int & nodeIdx) {
+	for (int i = 1; i < _queueCount; ++i) {
+		WorkQueue & q = _queues[(queueIdx + i) % _queueCount];
+		std::unique_lock<std::mutex> lck(q.lock);
+		if (!q.ready.empty()) {
+			nodeIdx = q.ready.front();
+			q.ready.pop_front();
+			_readyCount.fetch_sub(1);
+			return true;
+		}
+	}
+	return false;
+}
+void ParallelScheduler::RunUntilTickDone(int queueIdx) {
+	while (_remaining.load(std::memory_order_acquire) > 0) {
+		int nodeIdx;
+		if (TryPop(queueIdx, nodeIdx) || TrySteal(queueIdx, nodeIdx)) {
+			Node & node = _nodes[nodeIdx];
+			node.loop->OnLoop();
+
+			/* release dependents that are now ready */
+			for (int succ : node.successors) {
+				if (_nodes[succ].pending.fetch_sub(1, std::memory_order_acq_rel)
+						== 1) {
+					Push(queueIdx, succ);
+				}
+			}
+			if (_remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+				WakeParked(true); /* tick is done, release everyone */
+		} else {
+			/* others are finishing the last loopables, or dependencies are pending */
+			Park();
+		}
+	}
+}
+/**
+ * Sleep until a loopable is pushed or the tick is done.  Push() and the
+ * tick's last loopable take _parkLock before notifying, and a sleeper is
+ * counted before it checks for work, so a wakeup can't be missed.
+ */
+void ParallelScheduler::Park() {
+	std::unique_lock<std::mutex> lck(_parkLock);
+	_sleepers.fetch_add(1);
+	_parked.wait(lck, [&] {
+		return _readyCount.load() > 0
+				|| _remaining.load(std::memory_order_acquire) <= 0;
+	});
+	_sleepers.fetch_sub(1);
+}
+void ParallelScheduler::WakeParked(bool all) {
+	{
+		std::lock_guard<std::mutex> lck(_parkLock);
+	}
+	if (all)
+		_parked.notify_all();
+	else
+		_parked.notify_one();
+}
+void ParallelScheduler::WorkerMain(int queueIdx) {
+	uint32_t seenGeneration = 0;
+	for (;;) {
+		{
+			std::unique_lock<std::mutex> lck(_tickLock);
+			_tickStart.wait(lck, [&] {return _quit || _tickGeneration != seenGeneration;});
+			if (_quit)
+				return;
+			seenGeneration = _tickGeneration;
+		}
+		RunUntilTickDone(queueIdx);
+	}
+}
+void ParallelScheduler::Process() {
+	/* count enabled predecessors of each enabled loopable */
+	int enabledCnt = 0;
+	for (auto & node : _nodes) {
+		node.pending.store(0, std::memory_order_relaxed);
+	}
+	for (auto & node : _nodes) {
+		if (!node.enabled)
+			continue;
+		++enabledCnt;
+		for (int succ : node.successors) {
+			if (_nodes[succ].enabled)
+				_nodes[succ].pending.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+	if (enabledCnt == 0)
+		return;
+
+	/* seed the queues with loopables that have nothing to wait on */
+	int roundRobin = 0;
+	for (int i = 0; i < (int) _nodes.size(); ++i) {
+		Node & node = _nodes[i];
+		if (!node.enabled || node.pending.load(std::memory_order_relaxed) != 0)
+			continue;
+		int q;
+		if (node.startQueue >= 0) {
+			q = node.startQueue % _queueCount;
+		} else {
+			q = roundRobin;
+			roundRobin = (roundRobin + 1) % _queueCount;
+		}
+		Push(q, i);
+	}
+	_remaining.store(enabledCnt, std::memory_order_release);
+
+	/* wake workers and help out until the tick is joined */
+	{
+		std::unique_lock<std::mutex> lck(_tickLock);
+		++_tickGeneration;
+	}
+	_tickStart.notify_all();
+	RunUntilTickDone(0);
+}
+/* ILoopable */
+void ParallelScheduler::OnStart() {
+	ParallelScheduler::StartAll();
+}
+void ParallelScheduler::OnLoop() {
+	ParallelScheduler::Process();
+}
+void ParallelScheduler::OnStop() {
+	ParallelScheduler::StopAll();
+}
+bool ParallelScheduler::IsDone() {
+	return false;
+}
+
+} // namespace schedulers
+} // namespace tasking
+} // namespace phoenix
+} // namespace ctre
@@ -0,0 +1,230 @@
+#include "ctre/phoenix/Tasking/Schedulers/PriorityScheduler.h"
+#include "ctre/phoenix/MonotonicClock.h"
+#include <cstring>
+
+namespace ctre {
+namespace phoenix {
+namespace tasking {
+namespace schedulers {
+
+static inline uint32_t ClampU32(int64_t value) {
+	if (value < 0)
+		return 0;
+	if (value > UINT32_MAX)
+		return UINT32_MAX;
+	return (uint32_t) value;
+}
+
+/**
+ * Constructor
+ * @param tickBudgetUs time each Process() may spend before non-critical
+ *                     loopables start being deferred.
+ * @param criticalPriority loopables at or above this priority always run.
+ * @param maxDeferTicks consecutive deferrals after which a loopable is run
+ *                      regardless of budget, 0 to never force.
+ */
+PriorityScheduler::PriorityScheduler(int tickBudgetUs, int criticalPriority,
+		int maxDeferTicks) {
+	_tickBudgetNs = (int64_t) tickBudgetUs * 1000;
+	_criticalPriority = criticalPriority;
+	_maxDeferTicks = (maxDeferTicks > 0) ? (uint32_t) maxDeferTicks : 0;
+	ResetStats();
+}
+PriorityScheduler::~PriorityScheduler() {
+}
+/**
+ * @param aLoop loopable to add.
+ * @param priority larger runs first.
+ * @param budgetUs expected cost of one OnLoop, used to decide if it fits in
+ *                 the tick.  0 to use the measured average instead.  Runs
+ *                 longer than a nonzero budget are logged as overruns.
+ * @param enable true to have OnLoop called each Process().  OnStart is not
+ *               called, use Start() for that.  When added from inside
+ *               Process(), it first runs this tick only if it sorts after
+ *               the loopable currently running.
+ * @return handle for Start/Stop/IsStarted/GetLoopStats.
+ */
+PriorityScheduler::Handle PriorityScheduler::Add(ILoopable *aLoop,
+		int priority, int budgetUs, bool enable) {
+	Handle handle = (Handle) _entries.size();
+	Entry entry;
+	std::memset(&entry, 0, sizeof(entry));
+	entry.loop = aLoop;
+	entry.priority = priority;
+	entry.budgetNs = (budgetUs > 0) ? (uint32_t) budgetUs * 1000 : 0;
+	entry.enabled = enable;
+	_entries.push_back(entry);
+
+	/* insert after everything of same or higher priority, keeps add order */
+	unsigned int pos = 0;
+	while (pos < _order.size() && _entries[_order[pos]].priority >= priority)
+		++pos;
+	_order.insert(_order.begin() + pos, handle);
+	/* keep Process() on the same loopable, don't run it twice */
+	if (_processIndex >= 0 && (int) pos <= _processIndex)
+		++_processIndex;
+	return handle;
+}
+void PriorityScheduler::RemoveAll() {
+	_entries.clear();
+	_order.clear();
+	if (_processIndex >= 0)
+		_processIndex = 0;
+}
+void PriorityScheduler::Start(Handle handle) {
+	if (handle < 0 || handle >= (Handle) _entries.size())
+		return;
+	_entries[handle].enabled = true;
+	_entries[handle].consecutiveDeferrals = 0;
+	_entries[handle].loop->OnStart();
+}
+void PriorityScheduler::Stop(Handle handle) {
+	if (handle < 0 || handle >= (Handle) _entries.size())
+		return;
+	_entries[handle].enabled = false;
+	_entries[handle].loop->OnStop();
+}
+void PriorityScheduler::StartAll() {	//All Loops
+	for (Handle i = 0; i < (Handle) _entries.size(); ++i)
+		Start(i);
+}
+void PriorityScheduler::StopAll() {	//All Loops
+	for (Handle i = 0; i < (Handle) _entries.size(); ++i)
+		Stop(i);
+}
+bool PriorityScheduler::IsStarted(Handle handle) const {
+	if (handle < 0 || handle >= (Handle) _entries.size())
+		return false;
+	return _entries[handle].enabled;
+}
+int PriorityScheduler::GetCount() const {
+	return (int) _entries.size();
+}
+void PriorityScheduler::SetTickBudget(int tickBudgetUs) {
+	_tickBudgetNs = (int64_t) tickBudgetUs * 1000;
+}
+void PriorityScheduler::Log(Handle handle, Action action,
+		int64_t tickElapsedNs) {
+	Decision & d = _log[_logCount % kDecisionLogSize];
+	d.tick = _tickStats.ticks;
+	d.handle = handle;
+	d.action = action;
+	d.tickElapsedUs = ClampU32(tickElapsedNs / 1000);
+	++_logCount;
+}
+void PriorityScheduler::RunEntry(Handle handle, int64_t tickElapsedNs) {
+	int64_t start = MonotonicClock::NowNs();
+	_entries[handle].loop->OnLoop();
+	uint32_t execNs = ClampU32(MonotonicClock::NowNs() - start);
+
+	/* looked up after OnLoop in case it added loopables */
+	Entry & entry = _entries[handle];
+
+	/* first sample seeds the filter, then 1/8 gain */
+	if (entry.stats.runs == 0)
+		entry.avgExecNs = execNs;
+	else
+		entry.avgExecNs += ((int32_t) (execNs - entry.avgExecNs)) / 8;
+
+	++entry.stats.runs;
+	if (execNs / 1000 > entry.stats.maxExecUs)
+		entry.stats.maxExecUs = execNs / 1000;
+	if (entry.budgetNs > 0 && execNs > entry.budgetNs) {
+		++entry.stats.overruns;
+		Log(handle, Overran, tickElapsedNs + execNs);
+	}
+	entry.consecutiveDeferrals = 0;
+}
+void PriorityScheduler::Process() {
+	int64_t tickStart = MonotonicClock::NowNs();
+
+	/* index is a member and size is re-read so a loopable may add or stop
+	 * others, Add() shifts the index past anything inserted ahead of it */
+	for (_processIndex = 0; _processIndex < (int) _order.size();
+			++_processIndex) {
+		Handle handle = _order[_processIndex];
+		Entry & entry = _entries[handle];
+		if (!entry.enabled)
+			continue;
+
+		int64_t elapsed = MonotonicClock::NowNs() - tickStart;
+		if (entry.priority < _criticalPriority) {
+			int64_t cost = (entry.budgetNs > 0) ? entry.budgetNs : entry.avgExecNs;
+			if (elapsed + cost > _tickBudgetNs) {
+				if (_maxDeferTicks == 0
+						|| entry.consecutiveDeferrals < _maxDeferTicks) {
+					++entry.consecutiveDeferrals;
+					++entry.stats.deferrals;
+					Log(handle, Deferred, elapsed);
+					continue;
+				}
+				++entry.stats.forcedRuns;
+				Log(handle, ForcedRun, elapsed);
+			}
+		}
+		RunEntry(handle, elapsed);
+	}
+	_processIndex = -1;
+
+	uint32_t tickUs = ClampU32((MonotonicClock::NowNs() - tickStart) / 1000);
+	++_tickStats.ticks;
+	_tickStats.lastTickUs = tickUs;
+	if (tickUs > _tickStats.maxTickUs)
+		_tickStats.maxTickUs = tickUs;
+	if ((int64_t) tickUs * 1000 > _tickBudgetNs)
+		++_tickStats.overBudgetTicks;
+}
+void PriorityScheduler::GetLoopStats(Handle handle, LoopStats & toFill) const {
+	if (handle < 0 || handle >= (Handle) _entries.size()) {
+		std::memset(&toFill, 0, sizeof(toFill));
+		return;
+	}
+	toFill = _entries[handle].stats;
+	toFill.avgExecUs = _entries[handle].avgExecNs / 1000;
+}
+void PriorityScheduler::GetTickStats(TickStats & toFill) const {
+	toFill = _tickStats;
+}
+/**
+ * Copy the most recent policy decisions, oldest first.
+ * @param toFill array to fill.
+ * @param capacity size of array.
+ * @return number of decisions copied, at most kDecisionLogSize.
+ */
+int PriorityScheduler::GetDecisions(Decision * toFill, int capacity) const {
+	uint32_t count = _logCount;
+	if (count > (uint32_t) kDecisionLogSize)
+		count = kDecisionLogSize;
+	if (count > (uint32_t) capacity)
+		count = (capacity > 0) ? (uint32_t) capacity : 0;
+	uint32_t first = _logCount - count;
+	for (uint32_t i = 0; i < count; ++i)
+		toFill[i] = _log[(first + i) % kDecisionLogSize];
+	return (int) count;
+}
+void PriorityScheduler::ResetStats() {
+	std::memset(&_tickStats, 0, sizeof(_tickStats));
+	_logCount = 0;
+	for (auto & entry : _entries) {
+		std::memset(&entry.stats, 0, sizeof(entry.stats));
+		entry.consecutiveDeferrals = 0;
+	}
+}
+/* ILoopable */
+void PriorityScheduler::OnStart() {
+	PriorityScheduler::StartAll();
+}
+void PriorityScheduler::OnLoop() {
+	PriorityScheduler::Process();
+}
+void PriorityScheduler::OnStop() {
+	PriorityScheduler::StopAll();
+}
+bool PriorityScheduler::IsDone() {
+	return false;
+}
+
+} // namespace schedulers
+} // namespace tasking
+} // namespace phoenix
+} // namespace ctre
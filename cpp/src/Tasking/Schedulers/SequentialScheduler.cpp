@@ -32,14 +32,14 @@ void SequentialScheduler::Start() {
 		_running = false;
 	} else {
 		/* start the first one */
-		_loops[_idx]->OnStart();
+		CallOnStart(_idx);
 		_running = true;
 	}
 
 }
 void SequentialScheduler::Stop() {
 	for (unsigned int i = 0; i < _loops.size(); i++) {
-		_loops[i]->OnStop();
+		CallOnStop(i);
 	}
 	_running = false;
 }
@@ -47,13 +47,16 @@ void SequentialScheduler::Process() {
 	if (_idx < _loops.size()) {
 		if (_running) {
 			ILoopable* loop = _loops[_idx];
-			loop->OnLoop();
+			if (_profiler == nullptr)
+				loop->OnLoop();
+			else
+				_profiler->OnLoop((int) _idx, loop);
 			if (loop->IsDone()) {
 				/* iterate to next loopable */
 				++_idx;
 				if (_idx < _loops.size()) {
 					/* callback to start it */
-					_loops[_idx]->OnStart();
+					CallOnStart(_idx);
 				}
 			}
 		}
@@ -61,6 +64,26 @@ void SequentialScheduler::Process() {
 		_running = false;
 	}
 }
+/**
+ * @param profiler profiler to time every callback with, or null to stop
+ *                 profiling.  The index a loopable was added at is used as the
+ *                 profiler slot.  Caller keeps ownership.
+ */
+void SequentialScheduler::SetProfiler(LoopableProfiler * profiler) {
+	_profiler = profiler;
+}
+void SequentialScheduler::CallOnStart(unsigned int idx) {
+	if (_profiler == nullptr)
+		_loops[idx]->OnStart();
+	else
+		_profiler->OnStart((int) idx, _loops[idx]);
+}
+void SequentialScheduler::CallOnStop(unsigned int idx) {
+	if (_profiler == nullptr)
+		_loops[idx]->OnStop();
+	else
+		_profiler->OnStop((int) idx, _loops[idx]);
+}
 /* ILoopable */
 void SequentialScheduler::OnStart() {
 	SequentialScheduler::Start();
@@ -0,0 +1,142 @@
+#include "ctre/phoenix/Tasking/TimerWheel.h"
+
+namespace ctre {
+namespace phoenix {
+namespace tasking {
+
+static const uint32_t kSlotMask = TimerWheel::kSlots - 1;
+
+TimerWheel::TimerWheel() {
+	for (int l = 0; l < kLevels; ++l) {
+		for (int s = 0; s < kSlots; ++s)
+			_slots[l][s] = -1;
+	}
+}
+/**
+ * Start (or restart) a timer.
+ * @param id timer id, >= 0.  Ids should be small as storage is indexed by id.
+ * @param delayTicks number of Advance() calls until it expires.  0 is
+ *                   treated as 1, i.e. the next Advance().
+ */
+void TimerWheel::Schedule(int id, uint32_t delayTicks) {
+	if (id < 0)
+		return;
+	if (id >= (int) _nodes.size()) {
+		Node blank;
+		blank.prev = -1;
+		blank.next = -1;
+		blank.head = nullptr;
+		blank.expiry = 0;
+		_nodes.resize(id + 1, blank);
+	}
+	if (_nodes[id].head != nullptr)
+		Unlink(id);
+	else
+		++_scheduled;
+
+	if (delayTicks < 1)
+		delayTicks = 1;
+	if (delayTicks > kMaxDelay)
+		delayTicks = kMaxDelay;
+	_nodes[id].expiry = _now + delayTicks;
+	Insert(id);
+}
+void TimerWheel::Cancel(int id) {
+	if (!IsScheduled(id))
+		return;
+	Unlink(id);
+	--_scheduled;
+}
+void TimerWheel::CancelAll() {
+	for (int id = 0; id < (int) _nodes.size(); ++id)
+		Cancel(id);
+}
+bool TimerWheel::IsScheduled(int id) const {
+	return id >= 0 && id < (int) _nodes.size() && _nodes[id].head != nullptr;
+}
+/**
+ * @return ticks until timer expires, 0 if not scheduled.
+ */
+uint32_t TimerWheel::GetRemaining(int id) const {
+	if (!IsScheduled(id))
+		return 0;
+	return _nodes[id].expiry - _now;
+}
+int TimerWheel::GetScheduledCount() const {
+	return _scheduled;
+}
+/**
+ * @return ticks advanced since construction, wraps around.
+ */
+uint32_t TimerWheel::GetNow() const {
+	return _now;
+}
+/** place node in the finest level that can hold its remaining delay */
+void TimerWheel::Insert(int id) {
+	Node & node = _nodes[id];
+	uint32_t delta = node.expiry - _now;
+	int level = 0;
+	while (level < kLevels - 1 && delta >= (1u << (kSlotBits * (level + 1))))
+		++level;
+	int slot = (int) ((node.expiry >> (kSlotBits * level)) & kSlotMask);
+
+	int * head = &_slots[level][slot];
+	node.head = head;
+	node.prev = -1;
+	node.next = *head;
+	if (*head >= 0)
+		_nodes[*head].prev = id;
+	*head = id;
+}
+void TimerWheel::Unlink(int id) {
+	Node & node = _nodes[id];
+	if (node.prev >= 0)
+		_nodes[node.prev].next = node.next;
+	else
+		*node.head = node.next;
+	if (node.next >= 0)
+		_nodes[node.next].prev = node.prev;
+	node.head = nullptr;
+	node.prev = -1;
+	node.next = -1;
+}
+/** move every timer in level's current slot down to finer levels */
+void TimerWheel::Cascade(int level) {
+	int slot = (int) ((_now >> (kSlotBits * level)) & kSlotMask);
+	int id = _slots[level][slot];
+	_slots[level][slot] = -1;
+	while (id >= 0) {
+		int next = _nodes[id].next;
+		Insert(id);
+		id = next;
+	}
+}
+/**
+ * Move time forward one tick.
+ * @param handler notified of each timer expiring on this tick, may schedule
+ *                or cancel timers (including the one expiring).
+ */
+void TimerWheel::Advance(IExpiredHandler * handler) {
+	++_now;
+
+	/* coarser slots whose period starts now are spread out, top down */
+	int top = 0;
+	while (top < kLevels - 1 && ((_now >> (kSlotBits * top)) & kSlotMask) == 0)
+		++top;
+	for (int level = top; level > 0; --level)
+		Cascade(level);
+
+	/* everything left in this slot is due now.  A handler can't schedule
+	 * back into this slot as the minimum delay is one tick */
+	int * head = &_slots[0][_now & kSlotMask];
+	int id;
+	while ((id = *head) >= 0) {
+		Unlink(id);
+		--_scheduled;
+		handler->OnTimerExpired(id);
+	}
+}
+
+} // namespace tasking
+} // namespace phoenix
+} // namespace ctre
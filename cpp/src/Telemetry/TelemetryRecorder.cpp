@@ -0,0 +1,320 @@
+#include "ctre/phoenix/Telemetry/TelemetryRecorder.h"
+#include "ctre/phoenix/MonotonicClock.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <cmath>
+#include <cstring>
+
+namespace ctre {
+namespace phoenix {
+namespace telemetry {
+
+using namespace format;
+
+/** value / resolution, rounded and kept in range */
+static inline int64_t Quantize(double value, double invResolution) {
+	double q = value * invResolution;
+	if (!(q == q))
+		return 0; /* NaN */
+	if (q > 4.6e18)
+		return (int64_t) 4.6e18;
+	if (q < -4.6e18)
+		return (int64_t) -4.6e18;
+	return (int64_t) std::llround(q);
+}
+
+/**
+ * Constructor
+ * @param rowsPerBlock rows buffered before they are written to the file.
+ */
+TelemetryRecorder::TelemetryRecorder(int rowsPerBlock) {
+	_rowsPerBlock = (rowsPerBlock > 0) ? rowsPerBlock : 1;
+}
+TelemetryRecorder::~TelemetryRecorder() {
+	Close();
+}
+int TelemetryRecorder::Add(const char * name, const void * source,
+		SourceType sourceType, ColumnType type, double resolution) {
+	if (IsOpen() || (int) _columns.size() >= kMaxColumns || resolution <= 0)
+		return -1;
+	Column col;
+	col.source = source;
+	col.sourceType = sourceType;
+	col.type = type;
+	col.resolution = resolution;
+	col.invResolution = 1.0 / resolution;
+	strncpy(col.name, name, kNameLength - 1);
+	col.name[kNameLength - 1] = 0;
+	_columns.push_back(col);
+	return (int) _columns.size() - 1;
+}
+/**
+ * Record the variable at source every row.  Must be called before Open().
+ * @param name column name.
+ * @param source variable to sample, must outlive the recording.
+ * @return column index, or -1 if the recorder is already open or full.
+ */
+int TelemetryRecorder::AddSignal(const char * name, const int32_t * source) {
+	return Add(name, source, SourceInt32, Int, 1);
+}
+int TelemetryRecorder::AddSignal(const char * name, const uint32_t * source) {
+	return Add(name, source, SourceUInt32, Int, 1);
+}
+int TelemetryRecorder::AddSignal(const char * name, const bool * source) {
+	return Add(name, source, SourceBool, Bool, 1);
+}
+/**
+ * Record the variable at source every row.  Must be called before Open().
+ * @param name column name.
+ * @param source variable to sample, must outlive the recording.
+ * @param resolution smallest step recorded, values are rounded to it.
+ * @return column index, or -1 if the recorder is already open or full.
+ */
+int TelemetryRecorder::AddSignal(const char * name, const float * source,
+		double resolution) {
+	return Add(name, source, SourceFloat, Float, resolution);
+}
+int TelemetryRecorder::AddSignal(const char * name, const double * source,
+		double resolution) {
+	return Add(name, source, SourceDouble, Float, resolution);
+}
+/**
+ * Call source->Sample() at the start of every row, before the signals are
+ * read.  Must be called before Open().
+ * @return false if the recorder is already open.
+ */
+bool TelemetryRecorder::AddSource(ITelemetrySource * source) {
+	if (IsOpen())
+		return false;
+	_sources.push_back(source);
+	return true;
+}
+/**
+ * Create (or replace) the recording file and start recording.
+ * @param path file to create.
+ * @param fileBytes fixed size of the file, oldest rows are overwritten once
+ *                  it is full.
+ * @return OKAY, InvalidParamValue if the file is too small to hold a block,
+ *         GeneralError if the file cannot be created and mapped.
+ */
+ErrorCode TelemetryRecorder::Open(const char * path, int fileBytes) {
+	Close();
+
+	int columns = (int) _columns.size() + 1; /* plus timestamp */
+	_stride = _rowsPerBlock * kMaxVarintBytes;
+	uint32_t dataStart = DataStart((uint32_t) _columns.size());
+	uint32_t maxBlock = (uint32_t) (sizeof(BlockHeader) + 4 * columns
+			+ columns * _stride);
+	if (fileBytes <= 0 || (uint32_t) fileBytes < dataStart + maxBlock)
+		return InvalidParamValue;
+
+	_fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+	if (_fd < 0)
+		return GeneralError;
+	if (ftruncate(_fd, fileBytes) != 0) {
+		Close();
+		return GeneralError;
+	}
+	void * map = mmap(nullptr, fileBytes, PROT_READ | PROT_WRITE, MAP_SHARED,
+			_fd, 0);
+	if (map == MAP_FAILED) {
+		Close();
+		return GeneralError;
+	}
+	_map = (uint8_t *) map;
+	_mapBytes = (uint32_t) fileBytes;
+	/* touch every page now so recording never faults one in */
+	memset(_map, 0, _mapBytes);
+
+	FileHeader & h = Header();
+	memcpy(h.magic, kFileMagic, sizeof(h.magic));
+	h.version = kVersion;
+	h.columnCount = (uint32_t) _columns.size();
+	h.dataStart = dataStart;
+	h.dataEnd = _mapBytes;
+	h.head = h.tail = dataStart;
+	h.rowsPerBlock = (uint32_t) _rowsPerBlock;
+	h.blockCount = 0;
+	h.liveBlocks = 0;
+	ColumnDesc * descs = (ColumnDesc *) (_map + sizeof(FileHeader));
+	for (size_t i = 0; i < _columns.size(); ++i) {
+		memcpy(descs[i].name, _columns[i].name, kNameLength);
+		descs[i].type = _columns[i].type;
+		descs[i].resolution = _columns[i].resolution;
+	}
+
+	_buffer.assign(columns * _stride, 0);
+	_used.assign(columns, 0);
+	_prev.assign(columns, 0);
+	_rows = 0;
+	_wrapped = false;
+	_lapBlocks = 0;
+	return OKAY;
+}
+FileHeader & TelemetryRecorder::Header() {
+	return *(FileHeader *) _map;
+}
+void TelemetryRecorder::Append(int column, int64_t value) {
+	int64_t delta = value - _prev[column];
+	_prev[column] = value;
+	uint8_t * out = &_buffer[column * _stride + _used[column]];
+	_used[column] += PutVarint(out, ZigZag(delta));
+}
+/**
+ * Sample every signal, timestamped with the monotonic clock.
+ */
+void TelemetryRecorder::Record() {
+	Record(MonotonicClock::NowUs());
+}
+/**
+ * Sample every signal.
+ * @param timestampUs row timestamp in microseconds.
+ */
+void TelemetryRecorder::Record(int64_t timestampUs) {
+	if (!IsOpen())
+		return;
+	for (ITelemetrySource * source : _sources)
+		source->Sample();
+	Append(0, timestampUs);
+	int count = (int) _columns.size();
+	for (int i = 0; i < count; ++i) {
+		const Column & col = _columns[i];
+		int64_t value;
+		switch (col.sourceType) {
+		case SourceInt32:
+			value = *(const int32_t *) col.source;
+			break;
+		case SourceUInt32:
+			value = *(const uint32_t *) col.source;
+			break;
+		case SourceBool:
+			value = *(const bool *) col.source ? 1 : 0;
+			break;
+		case SourceFloat:
+			value = Quantize(*(const float *) col.source, col.invResolution);
+			break;
+		case SourceDouble:
+		default:
+			value = Quantize(*(const double *) col.source, col.invResolution);
+			break;
+		}
+		Append(i + 1, value);
+	}
+	if (++_rows >= _rowsPerBlock)
+		WriteBlock();
+}
+/**
+ * Move the tail past every old block overlapping [head, writeEnd).
+ */
+void TelemetryRecorder::AdvanceTail(uint32_t writeEnd) {
+	FileHeader & h = Header();
+	uint32_t tail = h.tail;
+	while (_wrapped && tail < writeEnd) {
+		uint32_t magic = 0;
+		if (tail + sizeof(BlockHeader) <= h.dataEnd)
+			memcpy(&magic, _map + tail, sizeof(magic));
+		if (magic == kBlockMagic) {
+			BlockHeader blk;
+			memcpy(&blk, _map + tail, sizeof(blk));
+			tail += blk.totalBytes;
+			h.liveBlocks--;
+		} else {
+			/* wrap marker or end of file, the previous lap is all gone */
+			tail = h.dataStart;
+			_wrapped = false;
+		}
+	}
+	h.tail = tail;
+}
+void TelemetryRecorder::WriteBlock() {
+	if (_rows == 0)
+		return;
+	FileHeader & h = Header();
+	int columns = (int) _used.size();
+	uint32_t bytes = (uint32_t) (sizeof(BlockHeader) + 4 * columns);
+	for (int c = 0; c < columns; ++c)
+		bytes += _used[c];
+
+	uint32_t head = h.head;
+	if (head + bytes > h.dataEnd) {
+		/* wrap, drop what is left of the previous lap past head */
+		if (head + sizeof(kWrapMagic) <= h.dataEnd)
+			memcpy(_map + head, &kWrapMagic, sizeof(kWrapMagic));
+		head = h.head = h.dataStart;
+		h.tail = h.dataStart;
+		h.liveBlocks = _lapBlocks;
+		_lapBlocks = 0;
+		_wrapped = true;
+	}
+	AdvanceTail(head + bytes);
+
+	BlockHeader blk;
+	blk.magic = kBlockMagic;
+	blk.sequence = h.blockCount;
+	blk.rowCount = (uint32_t) _rows;
+	blk.totalBytes = bytes;
+	uint8_t * out = _map + head;
+	memcpy(out, &blk, sizeof(blk));
+	out += sizeof(blk);
+	memcpy(out, _used.data(), 4 * columns);
+	out += 4 * columns;
+	for (int c = 0; c < columns; ++c) {
+		memcpy(out, &_buffer[c * _stride], _used[c]);
+		out += _used[c];
+	}
+	h.head = head + bytes;
+	h.blockCount++;
+	h.liveBlocks++;
+	_lapBlocks++;
+
+	/* next block starts its deltas from zero */
+	for (int c = 0; c < columns; ++c) {
+		_used[c] = 0;
+		_prev[c] = 0;
+	}
+	_rows = 0;
+}
+/**
+ * Write any buffered rows to the file now rather than waiting for a full
+ * block.
+ */
+void TelemetryRecorder::Flush() {
+	if (IsOpen())
+		WriteBlock();
+}
+/**
+ * Write buffered rows and close the file.
+ */
+void TelemetryRecorder::Close() {
+	if (_map != nullptr) {
+		WriteBlock();
+		msync(_map, _mapBytes, MS_ASYNC);
+		munmap(_map, _mapBytes);
+		_map = nullptr;
+		_mapBytes = 0;
+	}
+	if (_fd >= 0) {
+		close(_fd);
+		_fd = -1;
+	}
+}
+bool TelemetryRecorder::IsOpen() const {
+	return _map != nullptr;
+}
+int TelemetryRecorder::GetColumnCount() const {
+	return (int) _columns.size();
+}
+/**
+ * @return blocks written since Open().
+ */
+uint32_t TelemetryRecorder::GetBlockCount() const {
+	return IsOpen() ? ((const FileHeader *) _map)->blockCount : 0;
+}
+void TelemetryRecorder::Process() {
+	Record();
+}
+
+} // namespace telemetry
+} // namespace phoenix
+} // namespace ctre
@@ -0,0 +1,123 @@
+#include "ctre/phoenix/Telemetry/TelemetrySources.h"
+#include <stdio.h>
+#include <string.h>
+
+using namespace ctre::phoenix::motorcontrol;
+using namespace ctre::phoenix::tasking;
+
+namespace ctre {
+namespace phoenix {
+namespace telemetry {
+
+/** "<prefix>.<field>", truncated to fit a column name */
+class SignalName {
+public:
+	SignalName(const char * prefix, const char * field) {
+		snprintf(_name, sizeof(_name), "%s.%s", prefix, field);
+	}
+	operator const char *() const {
+		return _name;
+	}
+private:
+	char _name[format::kNameLength];
+};
+
+/**
+ * Constructor, adds the signals and this source to recorder.  Call before
+ * the recorder is opened.
+ * @param recorder recorder to add to.
+ * @param prefix start of each signal name.
+ * @param motorController controller to read each row.
+ * @param pidIdx closed loop whose sensor and error are recorded.
+ */
+MotorControllerTelemetry::MotorControllerTelemetry(TelemetryRecorder & recorder,
+		const char * prefix, IMotorController * motorController, int pidIdx) :
+		_motorController(motorController), _pidIdx(pidIdx) {
+	recorder.AddSignal(SignalName(prefix, "output"), &_output, 0.001);
+	recorder.AddSignal(SignalName(prefix, "busVoltage"), &_busVoltage, 0.01);
+	recorder.AddSignal(SignalName(prefix, "current"), &_current, 0.125);
+	recorder.AddSignal(SignalName(prefix, "temperature"), &_temperature, 0.1);
+	recorder.AddSignal(SignalName(prefix, "position"), &_position);
+	recorder.AddSignal(SignalName(prefix, "velocity"), &_velocity);
+	recorder.AddSignal(SignalName(prefix, "closedLoopError"),
+			&_closedLoopError);
+	recorder.AddSignal(SignalName(prefix, "faults"), &_faults);
+	recorder.AddSignal(SignalName(prefix, "lastError"), &_lastError);
+	recorder.AddSource(this);
+}
+void MotorControllerTelemetry::Sample() {
+	_output = _motorController->GetMotorOutputPercent();
+	_busVoltage = _motorController->GetBusVoltage();
+	_current = _motorController->GetOutputCurrent();
+	_temperature = _motorController->GetTemperature();
+	_position = _motorController->GetSelectedSensorPosition(_pidIdx);
+	_velocity = _motorController->GetSelectedSensorVelocity(_pidIdx);
+	_closedLoopError = _motorController->GetClosedLoopError(_pidIdx);
+	Faults faults;
+	_motorController->GetFaults(faults);
+	_faults = faults.ToBitfield();
+	_lastError = _motorController->GetLastError();
+}
+
+#ifndef CTR_EXCLUDE_WPILIB_CLASSES
+/**
+ * Constructor, adds the signals and this source to recorder.  Call before
+ * the recorder is opened.
+ * @param recorder recorder to add to.
+ * @param prefix start of each signal name.
+ * @param pigeon Pigeon to read each row.
+ */
+PigeonIMUTelemetry::PigeonIMUTelemetry(TelemetryRecorder & recorder,
+		const char * prefix, ctre::phoenix::sensors::PigeonIMU * pigeon) :
+		_pigeon(pigeon) {
+	recorder.AddSignal(SignalName(prefix, "yaw"), &_ypr[0], 0.01);
+	recorder.AddSignal(SignalName(prefix, "pitch"), &_ypr[1], 0.01);
+	recorder.AddSignal(SignalName(prefix, "roll"), &_ypr[2], 0.01);
+	recorder.AddSignal(SignalName(prefix, "gyroX"), &_rawGyro[0], 0.01);
+	recorder.AddSignal(SignalName(prefix, "gyroY"), &_rawGyro[1], 0.01);
+	recorder.AddSignal(SignalName(prefix, "gyroZ"), &_rawGyro[2], 0.01);
+	recorder.AddSignal(SignalName(prefix, "fusedHeading"), &_fusedHeading,
+			0.01);
+	recorder.AddSignal(SignalName(prefix, "temperature"), &_temperature, 0.1);
+	recorder.AddSignal(SignalName(prefix, "state"), &_state);
+	recorder.AddSignal(SignalName(prefix, "lastError"), &_lastError);
+	recorder.AddSource(this);
+}
+void PigeonIMUTelemetry::Sample() {
+	_pigeon->GetYawPitchRoll(_ypr);
+	_pigeon->GetRawGyro(_rawGyro);
+	_fusedHeading = _pigeon->GetFusedHeading();
+	_temperature = _pigeon->GetTemp();
+	_state = (int32_t) _pigeon->GetState();
+	_lastError = _pigeon->GetLastError();
+}
+#endif // CTR_EXCLUDE_WPILIB_CLASSES
+
+/**
+ * Constructor, adds the signals and this source to recorder.  Call before
+ * the recorder is opened.
+ * @param recorder recorder to add to.
+ * @param prefix start of each signal name.
+ * @param profiler profiler given to the scheduler with SetProfiler().
+ * @param slot the loopable's slot in the profiler.
+ */
+LoopableProfilerTelemetry::LoopableProfilerTelemetry(
+		TelemetryRecorder & recorder, const char * prefix,
+		const LoopableProfiler * profiler, int slot) :
+		_profiler(profiler), _slot(slot) {
+	memset(&_stats, 0, sizeof(_stats));
+	LoopableProfiler::CallStats & onLoop = _stats.onLoop;
+	recorder.AddSignal(SignalName(prefix, "calls"), &onLoop.calls);
+	recorder.AddSignal(SignalName(prefix, "overruns"), &onLoop.overruns);
+	recorder.AddSignal(SignalName(prefix, "meanUs"), &onLoop.meanUs);
+	recorder.AddSignal(SignalName(prefix, "p99Us"), &onLoop.p99Us);
+	recorder.AddSignal(SignalName(prefix, "maxUs"), &onLoop.maxUs);
+	recorder.AddSource(this);
+}
+void LoopableProfilerTelemetry::Sample() {
+	_profiler->GetStats(_slot, _stats);
+}
+
+} // namespace telemetry
+} // namespace phoenix
+} // namespace ctre
@@ -0,0 +1,158 @@
+#include "ctre/phoenix/ZoneProfiler.h"
+#include <stdio.h>
+#include <mutex>
+#include <vector>
+
+namespace ctre {
+namespace phoenix {
+
+namespace {
+struct Event {
+	const char * name;
+	int64_t startNs;
+	int64_t endNs;
+};
+/** written only by its own thread, read by the exporter up to count */
+struct ThreadBuffer {
+	Event events[ZoneProfiler::kEventsPerThread];
+	std::atomic<uint32_t> count;
+	int tid;
+};
+
+std::mutex s_lock; //!< guards s_buffers, not taken while recording
+std::vector<ThreadBuffer*> s_buffers; //!< buffers of live threads
+std::atomic<uint32_t> s_dropped(0);
+std::atomic<int> s_nextTid(1);
+
+/**
+ * Owns the calling thread's buffer.  Its destructor runs at thread exit and
+ * unregisters and frees the buffer, so threads that come and go don't leak.
+ */
+class ThreadBufferOwner {
+public:
+	ThreadBuffer * buffer = nullptr;
+	~ThreadBufferOwner() {
+		if (buffer == nullptr)
+			return;
+		std::lock_guard<std::mutex> lck(s_lock);
+		for (size_t i = 0; i < s_buffers.size(); ++i) {
+			if (s_buffers[i] == buffer) {
+				s_buffers[i] = s_buffers.back();
+				s_buffers.pop_back();
+				break;
+			}
+		}
+		delete buffer;
+		buffer = nullptr;
+	}
+};
+thread_local ThreadBufferOwner t_owner;
+
+ThreadBuffer * RegisterThread() {
+	ThreadBuffer * buffer = new ThreadBuffer();
+	buffer->count.store(0, std::memory_order_relaxed);
+	buffer->tid = s_nextTid.fetch_add(1, std::memory_order_relaxed);
+	std::lock_guard<std::mutex> lck(s_lock);
+	s_buffers.push_back(buffer);
+	return buffer;
+}
+void WriteEscaped(FILE * f, const char * str) {
+	for (; *str; ++str) {
+		char c = *str;
+		if (c == '"' || c == '\\')
+			fputc('\\', f);
+		if ((unsigned char) c >= 0x20)
+			fputc(c, f);
+	}
+}
+} // namespace
+
+std::atomic<bool> ZoneProfiler::_enabled(false);
+
+/**
+ * Start or stop recording.  Disabled by default.
+ */
+void ZoneProfiler::SetEnabled(bool enable) {
+	_enabled.store(enable, std::memory_order_relaxed);
+}
+/**
+ * Drop all recorded zones.  Call while disabled, a thread in the middle of
+ * recording a zone may otherwise keep it.
+ */
+void ZoneProfiler::Clear() {
+	std::lock_guard<std::mutex> lck(s_lock);
+	for (ThreadBuffer * buffer : s_buffers)
+		buffer->count.store(0, std::memory_order_relaxed);
+	s_dropped.store(0, std::memory_order_relaxed);
+}
+/**
+ * @return zones dropped because their thread's buffer was full.
+ */
+uint32_t ZoneProfiler::GetDroppedCount() {
+	return s_dropped.load(std::memory_order_relaxed);
+}
+void ZoneProfiler::Record(const char * name, int64_t startNs, int64_t endNs) {
+	ThreadBuffer * buffer = t_owner.buffer;
+	if (buffer == nullptr)
+		buffer = t_owner.buffer = RegisterThread();
+
+	uint32_t idx = buffer->count.load(std::memory_order_relaxed);
+	if (idx >= (uint32_t) kEventsPerThread) {
+		s_dropped.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+	Event & evt = buffer->events[idx];
+	evt.name = name;
+	evt.startNs = startNs;
+	evt.endNs = endNs;
+	/* publish after the event is filled in */
+	buffer->count.store(idx + 1, std::memory_order_release);
+}
+/**
+ * Write every recorded zone as Chrome trace event JSON.  Can be called while
+ * recording, zones finished after the snapshot of each thread are left out.
+ * @param path file to create.
+ * @return false if the file could not be written.
+ */
+bool ZoneProfiler::WriteChromeTrace(const char * path) {
+	FILE * f = fopen(path, "w");
+	if (f == nullptr)
+		return false;
+
+	std::lock_guard<std::mutex> lck(s_lock);
+
+	/* timestamps relative to the earliest zone keep the numbers readable */
+	int64_t baseNs = INT64_MAX;
+	for (ThreadBuffer * buffer : s_buffers) {
+		uint32_t n = buffer->count.load(std::memory_order_acquire);
+		for (uint32_t i = 0; i < n; ++i) {
+			if (buffer->events[i].startNs < baseNs)
+				baseNs = buffer->events[i].startNs;
+		}
+	}
+
+	fputs("{\"traceEvents\":[", f);
+	bool first = true;
+	for (ThreadBuffer * buffer : s_buffers) {
+		uint32_t n = buffer->count.load(std::memory_order_acquire);
+		for (uint32_t i = 0; i < n; ++i) {
+			const Event & evt = buffer->events[i];
+			fputs(first ? "\n{\"name\":\"" : ",\n{\"name\":\"", f);
+			first = false;
+			WriteEscaped(f, evt.name);
+			fprintf(f, "\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,"
+					"\"ts\":%.3f,\"dur\":%.3f}", buffer->tid,
+					(evt.startNs - baseNs) / 1000.0,
+					(evt.endNs - evt.startNs) / 1000.0);
+		}
+	}
+	fputs("\n],\"displayTimeUnit\":\"ms\"}\n", f);
+
+	bool ok = !ferror(f);
+	if (fclose(f) != 0)
+		ok = false;
+	return ok;
+}
+
+} // namespace phoenix
+} // namespace ctre
@@ -0,0 +1,114 @@
+/**
+ * Host benchmark for FilterBank.  Runs on the development machine, not part
+ * of the robot library.  Times one Process() of every FilterBank kind over
+ * kChannels signals, next to the same work done one signal at a time with
+ * the single-signal classes, so a change to either can be checked for a
+ * regression.
+ *
+ * Build:
+ *	g++ -std=c++14 -O3 -I../include FilterBankBench.cpp -o FilterBankBench
+ *	(add the robot's -march/-mfpu flags to see what the target vectorizes)
+ *
+ * Usage:
+ *	FilterBankBench [ticks]
+ *		ticks defaults to 1000000.  Prints ns per Process() call.
+ */
+#include "ctre/phoenix/Signals/FilterBank.h"
+#include "ctre/phoenix/Signals/FixedMovingAverage.h"
+#include "ctre/phoenix/Signals/MovingAverage.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+#include <memory>
+
+using namespace ctre::phoenix::signals;
+
+static const int kChannels = 36; //!< e.g. current, velocity, voltage of 12 controllers
+static const int kWindow = 8;
+static const int kInputRows = 256; //!< distinct input rows cycled through
+
+static float s_inputs[kInputRows][kChannels];
+static volatile float s_sink; //!< keeps results alive
+
+/** same pseudo random noise every run */
+static void FillInputs() {
+	uint32_t state = 12345;
+	for (int r = 0; r < kInputRows; ++r) {
+		for (int i = 0; i < kChannels; ++i) {
+			state = state * 1664525u + 1013904223u;
+			s_inputs[r][i] = (float) (state >> 8) / (float) (1 << 24) * 100.0f;
+		}
+	}
+}
+
+/**
+ * @param step called with (input row, output row) once per tick.
+ * @return ns per tick.
+ */
+template<typename Step>
+static double Time(long ticks, Step step) {
+	float out[kChannels];
+	auto start = std::chrono::steady_clock::now();
+	for (long t = 0; t < ticks; ++t) {
+		step(s_inputs[t & (kInputRows - 1)], out);
+		s_sink = out[t % kChannels];
+	}
+	auto stop = std::chrono::steady_clock::now();
+	return std::chrono::duration<double, std::nano>(stop - start).count()
+			/ (double) ticks;
+}
+static void Report(const char * name, double ns) {
+	printf("%-34s %8.1f ns/tick %6.2f ns/channel\n", name, ns,
+			ns / kChannels);
+}
+
+int main(int argc, char ** argv) {
+	long ticks = (argc > 1) ? atol(argv[1]) : 1000000;
+	if (ticks <= 0)
+		ticks = 1000000;
+	FillInputs();
+	printf("%d channels, %ld ticks\n", kChannels, ticks);
+
+	/* moving average */
+	{
+		FilterBank<filters::MovingAverage<kWindow>, kChannels> bank;
+		Report("FilterBank<MovingAverage<8>>", Time(ticks,
+				[&](const float * in, float * out) {bank.Process(in, out);}));
+	}
+	{
+		FixedMovingAverage<float, kWindow> avgs[kChannels];
+		Report("FixedMovingAverage<float,8> x36", Time(ticks,
+				[&](const float * in, float * out) {
+					for (int i = 0; i < kChannels; ++i)
+						out[i] = avgs[i].Process(in[i]);
+				}));
+	}
+	{
+		std::unique_ptr<MovingAverage> avgs[kChannels];
+		for (int i = 0; i < kChannels; ++i)
+			avgs[i].reset(new MovingAverage(kWindow));
+		Report("MovingAverage(8) x36", Time(ticks,
+				[&](const float * in, float * out) {
+					for (int i = 0; i < kChannels; ++i)
+						out[i] = avgs[i]->Process(in[i]);
+				}));
+	}
+
+	/* other kinds, bank only */
+	{
+		FilterBank<filters::FirstOrderIir, kChannels> bank(0.2f);
+		Report("FilterBank<FirstOrderIir>", Time(ticks,
+				[&](const float * in, float * out) {bank.Process(in, out);}));
+	}
+	{
+		FilterBank<filters::MedianOf5, kChannels> bank;
+		Report("FilterBank<MedianOf5>", Time(ticks,
+				[&](const float * in, float * out) {bank.Process(in, out);}));
+	}
+	{
+		FilterBank<filters::SlewLimiter, kChannels> bank(5.0f);
+		Report("FilterBank<SlewLimiter>", Time(ticks,
+				[&](const float * in, float * out) {bank.Process(in, out);}));
+	}
+	return 0;
+}
@@ -0,0 +1,282 @@
+/**
+ * Offline decoder for TelemetryRecorder files.  Runs on the development
+ * machine, not part of the robot library.
+ *
+ * Build:
+ *	g++ -std=c++14 -O2 -I../include TelemetryDecode.cpp -o TelemetryDecode
+ *
+ * Usage:
+ *	TelemetryDecode <recording> --info
+ *		print the layout and block count.
+ *	TelemetryDecode <recording> [out.csv]
+ *		one row per sample, timestamp_us first (stdout if no file given).
+ *	TelemetryDecode <recording> --columns <dir>
+ *		column oriented output, one <dir>/<column>.txt per column holding
+ *		one value per line, rows line up across files.
+ */
+#include "ctre/phoenix/Telemetry/TelemetryFormat.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+using namespace ctre::phoenix::telemetry::format;
+
+struct Recording {
+	std::vector<uint8_t> bytes;
+	FileHeader header;
+	std::vector<ColumnDesc> columns;
+	std::vector<int> decimals; //!< digits after the point per column
+};
+/** decoded block, values[column][row], column 0 is the timestamp */
+struct Block {
+	uint32_t rows;
+	std::vector<std::vector<int64_t> > values;
+};
+
+static bool Load(const char * path, Recording & rec) {
+	FILE * f = fopen(path, "rb");
+	if (f == nullptr) {
+		fprintf(stderr, "cannot open %s\n", path);
+		return false;
+	}
+	uint8_t chunk[65536];
+	size_t n;
+	while ((n = fread(chunk, 1, sizeof(chunk), f)) > 0)
+		rec.bytes.insert(rec.bytes.end(), chunk, chunk + n);
+	fclose(f);
+
+	if (rec.bytes.size() < sizeof(FileHeader)) {
+		fprintf(stderr, "%s is too short\n", path);
+		return false;
+	}
+	memcpy(&rec.header, rec.bytes.data(), sizeof(FileHeader));
+	const FileHeader & h = rec.header;
+	if (memcmp(h.magic, kFileMagic, sizeof(h.magic)) != 0
+			|| h.version != kVersion) {
+		fprintf(stderr, "%s is not a version %u telemetry recording\n", path,
+				(unsigned) kVersion);
+		return false;
+	}
+	if (h.dataEnd != rec.bytes.size() || h.dataStart != DataStart(h.columnCount)
+			|| h.head < h.dataStart || h.head > h.dataEnd
+			|| h.tail < h.dataStart || h.tail > h.dataEnd) {
+		fprintf(stderr, "%s has an inconsistent header\n", path);
+		return false;
+	}
+	rec.columns.resize(h.columnCount);
+	rec.decimals.resize(h.columnCount);
+	for (uint32_t i = 0; i < h.columnCount; ++i) {
+		ColumnDesc & desc = rec.columns[i];
+		memcpy(&desc, &rec.bytes[sizeof(FileHeader) + i * sizeof(ColumnDesc)],
+				sizeof(desc));
+		desc.name[kNameLength - 1] = 0;
+		/* enough digits to show every multiple of the resolution exactly */
+		int digits = 0;
+		if (desc.type == Float && desc.resolution > 0) {
+			double scaled = desc.resolution;
+			while (digits < 9 && fabs(scaled - floor(scaled + 0.5)) > 1e-9 * scaled) {
+				scaled *= 10;
+				++digits;
+			}
+		}
+		rec.decimals[i] = digits;
+	}
+	return true;
+}
+static bool DecodeBlock(const Recording & rec, uint32_t pos, Block & block) {
+	const uint8_t * base = rec.bytes.data();
+	const FileHeader & h = rec.header;
+	int columns = (int) h.columnCount + 1;
+	BlockHeader blk;
+	memcpy(&blk, base + pos, sizeof(blk));
+	uint32_t tableEnd = pos + sizeof(blk) + 4 * columns;
+	if (blk.totalBytes < tableEnd - pos || pos + blk.totalBytes > h.dataEnd)
+		return false;
+
+	std::vector<uint32_t> lengths(columns);
+	memcpy(lengths.data(), base + pos + sizeof(blk), 4 * columns);
+
+	block.rows = blk.rowCount;
+	block.values.assign(columns, std::vector<int64_t>());
+	const uint8_t * in = base + tableEnd;
+	const uint8_t * end = base + pos + blk.totalBytes;
+	for (int c = 0; c < columns; ++c) {
+		const uint8_t * colEnd = in + lengths[c];
+		if (colEnd > end)
+			return false;
+		int64_t value = 0;
+		block.values[c].reserve(blk.rowCount);
+		for (uint32_t r = 0; r < blk.rowCount; ++r) {
+			uint64_t zz;
+			int len = GetVarint(in, colEnd, zz);
+			if (len == 0)
+				return false;
+			in += len;
+			value += UnZigZag(zz);
+			block.values[c].push_back(value);
+		}
+		in = colEnd;
+	}
+	return true;
+}
+/**
+ * Call handler with every block from oldest to newest.
+ * @return blocks decoded, -1 if the ring is corrupt.
+ */
+template<typename Handler>
+static int ForEachBlock(const Recording & rec, Handler handler) {
+	const FileHeader & h = rec.header;
+	uint32_t pos = h.tail;
+	int count = 0;
+	bool jumped = false;
+	/* head == tail for both an empty and a full ring, walk by count */
+	while ((uint32_t) count < h.liveBlocks) {
+		uint32_t magic = 0;
+		if (pos + sizeof(BlockHeader) <= h.dataEnd)
+			memcpy(&magic, &rec.bytes[pos], sizeof(magic));
+		if (magic != kBlockMagic) {
+			/* wrap marker or end of file */
+			if (jumped)
+				return -1;
+			jumped = true;
+			pos = h.dataStart;
+			continue;
+		}
+		Block block;
+		if (!DecodeBlock(rec, pos, block))
+			return -1;
+		handler(block);
+		BlockHeader blk;
+		memcpy(&blk, &rec.bytes[pos], sizeof(blk));
+		pos += blk.totalBytes;
+		++count;
+	}
+	return count;
+}
+static void PrintValue(FILE * f, const Recording & rec, int column,
+		int64_t value) {
+	if (column == 0) {
+		fprintf(f, "%lld", (long long) value);
+		return;
+	}
+	const ColumnDesc & desc = rec.columns[column - 1];
+	if (desc.type == Float)
+		fprintf(f, "%.*f", rec.decimals[column - 1], value * desc.resolution);
+	else
+		fprintf(f, "%lld", (long long) value);
+}
+static int Info(const Recording & rec) {
+	const FileHeader & h = rec.header;
+	printf("columns: %u\nrows per block: %u\nblocks written: %u\n",
+			(unsigned) h.columnCount, (unsigned) h.rowsPerBlock,
+			(unsigned) h.blockCount);
+	for (uint32_t i = 0; i < h.columnCount; ++i) {
+		const ColumnDesc & desc = rec.columns[i];
+		const char * type = (desc.type == Float) ? "float" :
+							(desc.type == Bool) ? "bool" : "int";
+		printf("  %-40s %-5s", desc.name, type);
+		if (desc.type == Float)
+			printf(" resolution %g", desc.resolution);
+		printf("\n");
+	}
+	long long rows = 0;
+	int blocks = ForEachBlock(rec, [&](const Block & block) {
+		rows += block.rows;
+	});
+	if (blocks < 0) {
+		fprintf(stderr, "recording is corrupt\n");
+		return 1;
+	}
+	printf("blocks in file: %d\nrows in file: %lld\n", blocks, rows);
+	return 0;
+}
+static int WriteCsv(const Recording & rec, FILE * f) {
+	fprintf(f, "timestamp_us");
+	for (const ColumnDesc & desc : rec.columns)
+		fprintf(f, ",%s", desc.name);
+	fprintf(f, "\n");
+	int blocks = ForEachBlock(rec, [&](const Block & block) {
+		for (uint32_t r = 0; r < block.rows; ++r) {
+			for (size_t c = 0; c < block.values.size(); ++c) {
+				if (c > 0)
+					fputc(',', f);
+				PrintValue(f, rec, (int) c, block.values[c][r]);
+			}
+			fputc('\n', f);
+		}
+	});
+	if (blocks < 0) {
+		fprintf(stderr, "recording is corrupt\n");
+		return 1;
+	}
+	return 0;
+}
+static int WriteColumns(const Recording & rec, const char * dir) {
+	std::vector<FILE *> files;
+	int columns = (int) rec.columns.size() + 1;
+	for (int c = 0; c < columns; ++c) {
+		std::string name = (c == 0) ? "timestamp_us" : rec.columns[c - 1].name;
+		for (char & ch : name) {
+			if (ch == '/' || ch == '\\')
+				ch = '_';
+		}
+		std::string path = std::string(dir) + "/" + name + ".txt";
+		FILE * f = fopen(path.c_str(), "w");
+		if (f == nullptr) {
+			fprintf(stderr, "cannot create %s\n", path.c_str());
+			for (FILE * opened : files)
+				fclose(opened);
+			return 1;
+		}
+		files.push_back(f);
+	}
+	int blocks = ForEachBlock(rec, [&](const Block & block) {
+		for (int c = 0; c < columns; ++c) {
+			for (uint32_t r = 0; r < block.rows; ++r) {
+				PrintValue(files[c], rec, c, block.values[c][r]);
+				fputc('\n', files[c]);
+			}
+		}
+	});
+	for (FILE * f : files)
+		fclose(f);
+	if (blocks < 0) {
+		fprintf(stderr, "recording is corrupt\n");
+		return 1;
+	}
+	return 0;
+}
+
+int main(int argc, char ** argv) {
+	if (argc < 2) {
+		fprintf(stderr, "usage: %s <recording> [--info | out.csv | --columns <dir>]\n",
+				argv[0]);
+		return 2;
+	}
+	Recording rec;
+	if (!Load(argv[1], rec))
+		return 1;
+
+	if (argc >= 3 && strcmp(argv[2], "--info") == 0)
+		return Info(rec);
+	if (argc >= 3 && strcmp(argv[2], "--columns") == 0) {
+		if (argc < 4) {
+			fprintf(stderr, "--columns needs an output directory\n");
+			return 2;
+		}
+		return WriteColumns(rec, argv[3]);
+	}
+	if (argc >= 3) {
+		FILE * f = fopen(argv[2], "w");
+		if (f == nullptr) {
+			fprintf(stderr, "cannot create %s\n", argv[2]);
+			return 1;
+		}
+		int retval = WriteCsv(rec, f);
+		fclose(f);
+		return retval;
+	}
+	return WriteCsv(rec, stdout);
+}
@@ -1,23 +1,126 @@
 package com.ctre.phoenix;
 
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.atomic.AtomicInteger;
+
 public class Logger
 {
+	/** how often repeats of the same error are summarized */
+	private static final long kRepeatPeriodMs = 1000;
+	/** distinct code/origin pairs tracked, later ones are counted as dropped */
+	private static final int kMaxEntries = 256;
+
+	private static class Entry {
+		final ErrorCode code;
+		final String origin;
+		final AtomicInteger count = new AtomicInteger();
+		/* reporter thread only */
+		int reported = 1;
+
+		Entry(ErrorCode code, String origin) {
+			this.code = code;
+			this.origin = origin;
+		}
+	}
+	/** keyed by code, then origin, so a lookup never builds a key */
+	private static final ConcurrentHashMap<ErrorCode, ConcurrentHashMap<String, Entry>> _entries = new ConcurrentHashMap<ErrorCode, ConcurrentHashMap<String, Entry>>();
+	private static final AtomicInteger _entryCount = new AtomicInteger();
+	private static final AtomicInteger _dropped = new AtomicInteger();
+	private static Thread _reporter;
+
 	/**
-	 * Logs an entry into the Phoenix DS Error/Logger stream
+	 * Logs an entry into the Phoenix DS Error/Logger stream.
+	 * The first occurrence of each code and origin is sent with a stack trace,
+	 * repeats are only counted.  A background thread summarizes repeats at
+	 * most once per second.
 	 * @param code Error code to log.  If OKAY is passed, no action is taken.
 	 * @param origin Origin string to send to DS/Log
-	 * @return OKAY error code.
+	 * @return code.
 	 */
 	public static ErrorCode log(ErrorCode code, String origin) {
 		/* only take action if the error code is nonzero */
-		if (code != ErrorCode.OK) {
-			String stack = java.util.Arrays.toString(Thread.currentThread().getStackTrace());
-			stack = stack.replaceAll(",", "\n");
-			int errCode = code.value;
-			return ErrorCode.valueOf(CTRLoggerJNI.JNI_Logger_Log(errCode, origin, stack));
+		if (code == ErrorCode.OK)
+			return ErrorCode.OK;
+
+		ConcurrentHashMap<String, Entry> byOrigin = _entries.get(code);
+		if (byOrigin == null) {
+			ConcurrentHashMap<String, Entry> created = new ConcurrentHashMap<String, Entry>();
+			byOrigin = _entries.putIfAbsent(code, created);
+			if (byOrigin == null)
+				byOrigin = created;
+		}
+		Entry entry = byOrigin.get(origin);
+		if (entry != null) {
+			entry.count.incrementAndGet();
+			return code;
+		}
+		/* first occurrence, unless the table is full of other errors */
+		if (_entryCount.incrementAndGet() > kMaxEntries) {
+			_entryCount.decrementAndGet();
+			_dropped.incrementAndGet();
+			return code;
+		}
+		Entry created = new Entry(code, origin);
+		created.count.set(1);
+		entry = byOrigin.putIfAbsent(origin, created);
+		if (entry != null) {
+			/* another thread got there first */
+			_entryCount.decrementAndGet();
+			entry.count.incrementAndGet();
+			return code;
+		}
+		startReporter();
+		StringBuilder stack = new StringBuilder();
+		for (StackTraceElement element : Thread.currentThread().getStackTrace()) {
+			stack.append(element).append('\n');
+		}
+		CTRLoggerJNI.JNI_Logger_Log(code.value, origin, stack.toString());
+		return code;
+	}
+	/**
+	 * @return errors not reported because too many distinct errors were seen.
+	 */
+	public static int getDroppedCount() {
+		return _dropped.get();
+	}
+
+	private static synchronized void startReporter() {
+		if (_reporter != null)
+			return;
+		_reporter = new Thread(new Runnable() {
+			public void run() {
+				while (true) {
+					try {
+						Thread.sleep(kRepeatPeriodMs);
+					} catch (InterruptedException e) {
+						/* send what is pending, then quit */
+						reportRepeats();
+						return;
+					}
+					reportRepeats();
+				}
+			}
+		}, "Phoenix Logger");
+		_reporter.setDaemon(true);
+		Runtime.getRuntime().addShutdownHook(new Thread(new Runnable() {
+			public void run() {
+				/* last burst of repeats since the previous summary */
+				reportRepeats();
+			}
+		}));
+		_reporter.start();
+	}
+	private static synchronized void reportRepeats() {
+		for (ConcurrentHashMap<String, Entry> byOrigin : _entries.values()) {
+			for (Entry entry : byOrigin.values()) {
+				int count = entry.count.get();
+				if (count == entry.reported)
+					continue;
+				int repeats = count - entry.reported;
+				entry.reported = count;
+				CTRLoggerJNI.JNI_Logger_Log(entry.code.value, entry.origin + " (repeated " + repeats + " times)", "");
+			}
 		}
-		/* otherwise return OK */
-		return ErrorCode.OK;
 	}
 
 	//public static void close() {
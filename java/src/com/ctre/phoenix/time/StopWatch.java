@@ -1,25 +1,35 @@
 package com.ctre.phoenix.time;
 
+/**
+ * Measures elapsed wall time using the monotonic System.nanoTime(), so
+ * durations are unaffected by system clock changes.
+ */
 public class StopWatch
 {
-	private long _t0 = 0;
-	private long _t1 = 0;
+	private long _t0 = System.nanoTime();
 	
 	public void start()
 	{
-		_t0 = System.currentTimeMillis();
+		_t0 = System.nanoTime();
 	}
 	
 	public double getDuration()
 	{
-		return (double)getDurationMs() / 1000;
+		return (double)getDurationNs() / 1000000000;
 	}
 	public int getDurationMs()
 	{
-		_t1 = System.currentTimeMillis();
-		long retval = _t1 - _t0;
+		return (int)(getDurationNs() / 1000000);
+	}
+	public long getDurationUs()
+	{
+		return getDurationNs() / 1000;
+	}
+	public long getDurationNs()
+	{
+		long retval = System.nanoTime() - _t0;
 		if(retval < 0)
 			retval = 0;
-		return (int)retval;
+		return retval;
 	}
-}
\ No newline at end of file
+}